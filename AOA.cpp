@@ -1,3 +1,4 @@
+#pragma once
 #include <vector>
 #include <random>
 #include <algorithm>
@@ -5,6 +6,10 @@
 #include <numeric>
 #include <ctime>
 #include "benchmarks.h"
+#include "random.cpp"
+#include "termination.cpp"
+#include "snapshot.cpp"
+#include "initialization.cpp"
 
 // Creating a random number generator based on the current time
 std::default_random_engine generator(std::chrono::system_clock::now().time_since_epoch().count());
@@ -22,27 +27,33 @@ std::vector<double> updatePosition(const std::vector<double>& agent, double t, c
 
 // The main function for optimization based on the algorithm
 std::pair<std::vector<double>, double> aoa(int num_agents, int max_iter, const std::vector<std::pair<double, double>>& search_space,
-                                           double (*benchmark_function)(const std::vector<double>&)) {
+                                           const Objective& benchmark_function, RunSnapshots* snapshots = nullptr) {
     int num_features = search_space.size();
     std::vector<std::vector<double>> agents(num_agents, std::vector<double>(num_features));
+    std::vector<double> fitness(num_agents, std::numeric_limits<double>::infinity());
+    auto state = [&](SnapshotArchive& archive) {
+        archive.field(agents);
+        archive.field(fitness);
+    };
+    int t = 0;
+    bool solved = false;
 
-    // Initialization of the population
-    for(int i = 0; i < num_agents; i++) {
-        for(int j = 0; j < num_features; j++) {
-            agents[i][j] = getRandomValue(search_space[j].first, search_space[j].second);
-        }
-    }
+    if (!restore_snapshot(snapshots, "AOA", t, state)) {
+        // Initialization of the population
+        initialize_population(agents, search_space);
 
-    std::vector<double> fitness(num_agents, std::numeric_limits<double>::infinity());
+        // Using the benchmark_function function for initialized agents
+        std::for_each(agents.begin(), agents.end(), [&](const std::vector<double>& agent) {
+            int i = &agent - &agents[0];
+            fitness[i] = benchmark_function(agent);
+        });
 
-    // Using the benchmark_function function for initialized agents
-    std::for_each(agents.begin(), agents.end(), [&](const std::vector<double>& agent) {
-        int i = &agent - &agents[0];
-        fitness[i] = benchmark_function(agent);
-    });
+        solved = target_reached(*std::min_element(fitness.begin(), fitness.end()));
+    }
 
-    // Main optimization cycle
-    for (int t = 0; t < max_iter; t++) {
+    // Main optimization cycle, until the budget is spent or the target is reached
+    for (; t < max_iter && !solved; t++) {
+        checkpoint_snapshot(snapshots, "AOA", t, state);
         double time_ratio = static_cast<double>(t) / max_iter;
 
         for (int i = 0; i < num_agents; i++) {
@@ -52,6 +63,10 @@ std::pair<std::vector<double>, double> aoa(int num_agents, int max_iter, const s
                 agents[i] = std::move(new_position);
                 fitness[i] = new_fitness;
             }
+            if (target_reached(new_fitness)) {
+                solved = true;
+                break;
+            }
         }
     }
     
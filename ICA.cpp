@@ -1,3 +1,4 @@
+#pragma once
 #include <vector>
 #include <algorithm>
 #include <cmath>
@@ -6,41 +7,50 @@
 #include <chrono>
 #include <functional>
 #include "benchmarks.h"
+#include "random.cpp"
+#include "termination.cpp"
+#include "snapshot.cpp"
+#include "initialization.cpp"
 
 // Main ICA function
 std::pair<std::vector<double>, double> ica(int num_agents, int max_iter, const std::vector<std::pair<double, double>>& search_space,
-                                           int num_empires, double (*benchmark_function)(const std::vector<double>&)) {
+                                           int num_empires, const Objective& benchmark_function, RunSnapshots* snapshots = nullptr) {
     int num_dimensions = search_space.size();
-    std::vector<std::vector<double>> agents(num_agents, std::vector<double>(num_dimensions));
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
-
-    for (int i = 0; i < num_agents; ++i) {
-        for (int j = 0; j < num_dimensions; ++j) {
-            agents[i][j] = search_space[j].first + (search_space[j].second - search_space[j].first) * static_cast<double>(std::rand()) / RAND_MAX;
-        }
-    }
-
-    std::vector<double> fitness(num_agents);
-    for (int i = 0; i < num_agents; ++i) {
-        fitness[i] = benchmark_function(agents[i]);
-    }
-
-    std::vector<int> sorted_indices(num_agents);
-    std::iota(sorted_indices.begin(), sorted_indices.end(), 0);
-    std::sort(sorted_indices.begin(), sorted_indices.end(), [&fitness](int i1, int i2) { return fitness[i1] < fitness[i2]; });
-
     std::vector<std::vector<double>> empires(num_empires);
     std::vector<std::vector<double>> colonies(num_agents - num_empires);
     std::vector<double> empire_fitness(num_empires);
     std::vector<double> colony_fitness(num_agents - num_empires);
+    auto state = [&](SnapshotArchive& archive) {
+        archive.field(empires);
+        archive.field(colonies);
+        archive.field(empire_fitness);
+        archive.field(colony_fitness);
+    };
+    int t = 0;
+    bool resumed = restore_snapshot(snapshots, "ICA", t, state);
 
-    for (int i = 0; i < num_empires; ++i) {
-        empires[i] = agents[sorted_indices[i]];
-        empire_fitness[i] = fitness[sorted_indices[i]];
-    }
-    for (int i = 0; i < colonies.size(); ++i) {
-        colonies[i] = agents[sorted_indices[i + num_empires]];
-        colony_fitness[i] = fitness[sorted_indices[i + num_empires]];
+    if (!resumed) {
+        std::vector<std::vector<double>> agents(num_agents, std::vector<double>(num_dimensions));
+
+        initialize_population(agents, search_space);
+
+        std::vector<double> fitness(num_agents);
+        for (int i = 0; i < num_agents; ++i) {
+            fitness[i] = benchmark_function(agents[i]);
+        }
+
+        std::vector<int> sorted_indices(num_agents);
+        std::iota(sorted_indices.begin(), sorted_indices.end(), 0);
+        std::sort(sorted_indices.begin(), sorted_indices.end(), [&fitness](int i1, int i2) { return fitness[i1] < fitness[i2]; });
+
+        for (int i = 0; i < num_empires; ++i) {
+            empires[i] = agents[sorted_indices[i]];
+            empire_fitness[i] = fitness[sorted_indices[i]];
+        }
+        for (int i = 0; i < colonies.size(); ++i) {
+            colonies[i] = agents[sorted_indices[i + num_empires]];
+            colony_fitness[i] = fitness[sorted_indices[i + num_empires]];
+        }
     }
 
     // Initialization of adaptive learning rates and assimilation coefficients
@@ -49,14 +59,18 @@ std::pair<std::vector<double>, double> ica(int num_agents, int max_iter, const s
     double assimilation_coeff_init = 0.5;
     double assimilation_coeff_final = 0.1;
 
-    for (int t = 0; t < max_iter; ++t) {
+    // Only the empires count: the result is the best empire
+    bool solved = !resumed && target_reached(*std::min_element(empire_fitness.begin(), empire_fitness.end()));
+
+    for (; t < max_iter && !solved; ++t) {
+        checkpoint_snapshot(snapshots, "ICA", t, state);
         double assimilation_coeff = assimilation_coeff_init - (assimilation_coeff_init - assimilation_coeff_final) * static_cast<double>(t) / max_iter;
         double learning_rate = learning_rate_init - (learning_rate_init - learning_rate_final) * static_cast<double>(t) / max_iter;
 
         // We are crossing between empires
         for (int i = 0; i < num_empires; ++i) {
-            if (static_cast<double>(std::rand()) / RAND_MAX < 0.5) {
-                int other = std::rand() % num_empires;
+            if (randomUnit() < 0.5) {
+                int other = getRandomIndex(num_empires);
                 std::vector<double> child(num_dimensions);
                 for (int j = 0; j < num_dimensions; ++j) {
                     child[j] = 0.5 * (empires[i][j] + empires[other][j]);
@@ -66,8 +80,13 @@ std::pair<std::vector<double>, double> ica(int num_agents, int max_iter, const s
                     empires[i] = child;
                     empire_fitness[i] = child_fitness;
                 }
+                if (target_reached(child_fitness)) {
+                    solved = true;
+                    break;
+                }
             }
         }
+        if (solved) break;
 
         // Updating colony positions based on their respective empires
         for (int i = 0; i < colonies.size(); ++i) {
@@ -79,14 +98,16 @@ std::pair<std::vector<double>, double> ica(int num_agents, int max_iter, const s
         // A revolution is being carried out by introducing random disturbances
         for (int i = 0; i < colonies.size(); ++i) {
             for (int j = 0; j < num_dimensions; ++j) {
-                colonies[i][j] += 0.2 * static_cast<double>(rand()) / RAND_MAX;
+                colonies[i][j] += 0.2 * randomUnit();
             }
         }
 
         // Updating the fitness of all agents
-        for (int i = 0; i < num_empires; ++i) {
+        for (int i = 0; i < num_empires && !solved; ++i) {
             empire_fitness[i] = benchmark_function(empires[i]);
+            solved = target_reached(empire_fitness[i]);
         }
+        if (solved) break;
         for (int i = 0; i < colonies.size(); ++i) {
             colony_fitness[i] = benchmark_function(colonies[i]);
         }
@@ -95,10 +116,6 @@ std::pair<std::vector<double>, double> ica(int num_agents, int max_iter, const s
         int best_index = std::distance(empire_fitness.begin(), std::min_element(empire_fitness.begin(), empire_fitness.end()));
         auto best_agent = empires[best_index];
         double best_fitness = empire_fitness[best_index];
-
-        if (*std::min_element(empire_fitness.begin(), empire_fitness.end()) < 1e-9) {
-            break;
-        }
     }
 
     int best_index = std::distance(empire_fitness.begin(), std::min_element(empire_fitness.begin(), empire_fitness.end()));
@@ -7,6 +7,8 @@
 #include <functional>
 #include "benchmarks.h"
 #include <fstream>
+#include "termination.cpp"
+#include "metrics.cpp"
 
 
 // Main ICA function
@@ -17,6 +19,8 @@ std::pair<std::vector<double>, double> ica(int num_agents, int max_iter, const s
     std::srand(static_cast<unsigned>(std::time(nullptr)));
 
     std::ofstream log_file("results.txt", std::ios_base::app);
+    RunProgress progress("ICA", benchmark_number);
+    uint64_t evaluations = 0;
 
     for (int i = 0; i < num_agents; ++i) {
         for (int j = 0; j < num_dimensions; ++j) {
@@ -27,6 +31,7 @@ std::pair<std::vector<double>, double> ica(int num_agents, int max_iter, const s
     std::vector<double> fitness(num_agents);
     for (int i = 0; i < num_agents; ++i) {
         fitness[i] = benchmark_function(agents[i]);
+        ++evaluations;
     }
 
     std::vector<int> sorted_indices(num_agents);
@@ -53,7 +58,9 @@ std::pair<std::vector<double>, double> ica(int num_agents, int max_iter, const s
     double assimilation_coeff_init = 0.5;
     double assimilation_coeff_final = 0.1;
 
-    for (int t = 0; t < max_iter; ++t) {
+    bool solved = target_reached(*std::min_element(empire_fitness.begin(), empire_fitness.end()));
+
+    for (int t = 0; t < max_iter && !solved; ++t) {
         double assimilation_coeff = assimilation_coeff_init - (assimilation_coeff_init - assimilation_coeff_final) * static_cast<double>(t) / max_iter;
         double learning_rate = learning_rate_init - (learning_rate_init - learning_rate_final) * static_cast<double>(t) / max_iter;
 
@@ -66,6 +73,7 @@ std::pair<std::vector<double>, double> ica(int num_agents, int max_iter, const s
                     child[j] = 0.5 * (empires[i][j] + empires[other][j]);
                 }
                 double child_fitness = benchmark_function(child);
+                ++evaluations;
                 if (child_fitness < empire_fitness[i]) {
                     empires[i] = child;
                     empire_fitness[i] = child_fitness;
@@ -90,14 +98,16 @@ std::pair<std::vector<double>, double> ica(int num_agents, int max_iter, const s
         // Обновление приспособленности всех агентов
         for (int i = 0; i < num_empires; ++i) {
             empire_fitness[i] = benchmark_function(empires[i]);
+            ++evaluations;
         }
         for (int i = 0; i < colonies.size(); ++i) {
             colony_fitness[i] = benchmark_function(colonies[i]);
+            ++evaluations;
         }
 
         double current_best_fitness = *std::min_element(empire_fitness.begin(), empire_fitness.end());
-        std::cout << "\rBenchmark " << benchmark_number << ", Iteration " << t << ": Best Fitness = " << std::setprecision(5) << current_best_fitness << std::flush;
-        log_file << "Benchmark " << benchmark_number << ", Iteration " << t << ": Best Fitness = " << std::setprecision(5) << current_best_fitness << std::endl;
+        progress.report(t, evaluations, current_best_fitness);
+        log_file << "Benchmark " << benchmark_number << ", Iteration " << t << ": Best Fitness = " << std::setprecision(5) << current_best_fitness << '\n';
 
 
         // Поиск лучшей империи
@@ -105,9 +115,7 @@ std::pair<std::vector<double>, double> ica(int num_agents, int max_iter, const s
         auto best_agent = empires[best_index];
         double best_fitness = empire_fitness[best_index];
 
-        if (*std::min_element(empire_fitness.begin(), empire_fitness.end()) < 1e-9) {
-            break;
-        }
+        solved = target_reached(best_fitness);
     }
 
     log_file.close();
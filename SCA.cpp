@@ -1,13 +1,15 @@
+#pragma once
 #include <vector>
 #include <random>
 #include <algorithm>
+#include "benchmarks.h"
+#include "random.cpp"
+#include "termination.cpp"
+#include "snapshot.cpp"
+#include "initialization.cpp"
+#include "diversity.cpp"
 
 // Вспомогательные функции
-double getRandomValue(double min, double max) {
-    static std::default_random_engine generator;
-    std::uniform_real_distribution<double> distribution(min, max);
-    return distribution(generator);
-}
 
 std::vector<double> calculateDifferenceSCA(const std::vector<double>& v1, const std::vector<double>& v2, double C) {
     std::vector<double> result(v1.size());
@@ -28,26 +30,44 @@ std::vector<double> calculateDifferenceRandomPositonSCA(const std::vector<double
 
 // Основная функция SCA
 std::pair<std::vector<double>, double> sca(int num_agents, int max_iter, const std::vector<std::pair<double, double>>& search_space,
-                                           double (*benchmark_function)(const std::vector<double>&)) {
+                                           const Objective& benchmark_function, RunSnapshots* snapshots = nullptr) {
     int num_features = search_space.size();
     std::vector<std::vector<double>> agents(num_agents, std::vector<double>(num_features));
+    std::vector<double> fitness(num_agents);
+    // Restarts (diversity.cpp) grow the population and start the schedule of the iterations over
+    DiversityMonitor monitor(num_agents, search_space);
+    agents.reserve(monitor.capacity());
+    fitness.reserve(monitor.capacity());
+    int epoch_start = 0, epoch_length = max_iter, end = max_iter;
+    auto state = [&](SnapshotArchive& archive) {
+        archive.field(agents);
+        archive.field(fitness);
+        // Always present, so a snapshot restores whatever --diversity the resumed run is given
+        archive.field(epoch_start);
+        archive.field(epoch_length);
+        monitor.snapshotFields(archive);
+    };
+    int t = 0;
+    bool solved = false;
+
+    if (!restore_snapshot(snapshots, "SCA", t, state)) {
+        // Инициализация популяции
+        initialize_population(agents, search_space);
 
-    // Инициализация популяции
-    for(int i = 0; i < num_agents; i++) {
-        for(int j = 0; j < num_features; j++) {
-            agents[i][j] = getRandomValue(search_space[j].first, search_space[j].second);
+        for(int i = 0; i < num_agents; i++) {
+            fitness[i] = benchmark_function(agents[i]);
         }
+        solved = target_reached(*std::min_element(fitness.begin(), fitness.end()));
     }
 
-    std::vector<double> fitness(num_agents);
+    num_agents = agents.size();
+    end = epoch_start + epoch_length;
+    monitor.start(agents, fitness);
 
-    for(int i = 0; i < num_agents; i++) {
-        fitness[i] = benchmark_function(agents[i]);
-    }
-
-    for (int t = 0; t < max_iter; t++) {
+    for (; t < end && !solved; t++) {
+        checkpoint_snapshot(snapshots, "SCA", t, state);
         for (int i = 0; i < num_agents; i++) {
-            double a_t = 2.0 - double(t) * (2.0 / double(max_iter));
+            double a_t = 2.0 - double(t - epoch_start) * (2.0 / double(epoch_length));
             double r1 = getRandomValue(0, 1);
             double r2 = getRandomValue(0, 1);
             double A = 2 * a_t * r1 - a_t;
@@ -63,9 +83,25 @@ std::pair<std::vector<double>, double> sca(int num_agents, int max_iter, const s
 
             double new_fitness = benchmark_function(new_position);
             if (new_fitness < fitness[i]) {
+                monitor.replace(agents[i], new_position, new_fitness);
                 agents[i] = new_position;
                 fitness[i] = new_fitness;
             }
+            if (target_reached(new_fitness)) {
+                solved = true;
+                break;
+            }
+        }
+        if (!solved && monitor.endIteration(agents)) {
+            int iterations = restart_population(agents, fitness, static_cast<long long>(num_agents) * (end - t - 1),
+                                                search_space, benchmark_function, monitor);
+            if (iterations > 0) {
+                num_agents = agents.size();
+                epoch_start = t + 1;
+                epoch_length = iterations;
+                end = epoch_start + epoch_length;
+                solved = target_reached(*std::min_element(fitness.begin(), fitness.end()));
+            }
         }
     }
 
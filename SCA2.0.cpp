@@ -4,19 +4,9 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
-
-// Вспомогательные функции
-double getRandomValue(double min, double max) {
-    static std::default_random_engine generator;
-    std::uniform_real_distribution<double> distribution(min, max);
-    return distribution(generator);
-}
-
-int getRandomIndex(int max_index) {
-    static std::default_random_engine generator;
-    std::uniform_int_distribution<int> distribution(0, max_index-1);
-    return distribution(generator);
-}
+#include "random.cpp"
+#include "termination.cpp"
+#include "metrics.cpp"
 
 std::vector<double> calculateDifferenceSCA(const std::vector<double>& v1, const std::vector<double>& v2, double C) {
     std::vector<double> result(v1.size());
@@ -42,6 +32,8 @@ std::pair<std::vector<double>, double> sca(int num_agents, int max_iter, const s
     std::vector<std::vector<double>> agents(num_agents, std::vector<double>(num_features));
 
     std::ofstream log_file("results.txt", std::ios_base::app); // инициализация файла для записи
+    RunProgress progress("SCA", benchmark_number);
+    uint64_t evaluations = 0;
 
     // Инициализация популяции
     for(int i = 0; i < num_agents; i++) {
@@ -53,9 +45,13 @@ std::pair<std::vector<double>, double> sca(int num_agents, int max_iter, const s
     std::vector<double> fitness(num_agents);
     for(int i = 0; i < num_agents; i++) {
         fitness[i] = benchmark_function(agents[i]);
+        ++evaluations;
     }
+    // Agents are only replaced by better points, so the best is a running minimum
+    double best_fitness = *std::min_element(fitness.begin(), fitness.end());
+    bool solved = target_reached(best_fitness);
 
-    for (int t = 0; t < max_iter; t++) {
+    for (int t = 0; t < max_iter && !solved; t++) {
         for (int i = 0; i < num_agents; i++) {
             double a_t = 2.0 - double(t) * (2.0 / double(max_iter));
             double r1 = getRandomValue(0, 1);
@@ -72,15 +68,20 @@ std::pair<std::vector<double>, double> sca(int num_agents, int max_iter, const s
             std::vector<double> new_position = calculateDifferenceRandomPositonSCA(random_agent, D, A);
 
             double new_fitness = benchmark_function(new_position);
+            ++evaluations;
             if (new_fitness < fitness[i]) {
                 agents[i] = new_position;
                 fitness[i] = new_fitness;
+                best_fitness = std::min(best_fitness, new_fitness);
             }
-            double current_best_fitness = *std::min_element(fitness.begin(), fitness.end());
-            std::cout << "\rBenchmark " << benchmark_number << ", Iteration " << t << ": Best Fitness = " << std::setprecision(5) << current_best_fitness << std::flush;
-            log_file << "Benchmark " << benchmark_number << ", Iteration " << t << ": Best Fitness = " << std::setprecision(5) << current_best_fitness << std::endl;
+            progress.report(t, evaluations, best_fitness);
 
+            if (target_reached(best_fitness)) {
+                solved = true;
+                break;
+            }
         }
+        log_file << "Benchmark " << benchmark_number << ", Iteration " << t << ": Best Fitness = " << std::setprecision(5) << best_fitness << '\n';
     }
 
     log_file.close(); // закрыть файл
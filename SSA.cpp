@@ -1,3 +1,4 @@
+#pragma once
 #include <iostream>
 #include <vector>
 #include <algorithm>
@@ -5,28 +6,37 @@
 #include <numeric>
 #include <ctime>
 #include "benchmarks.h"
+#include "random.cpp"
+#include "termination.cpp"
+#include "snapshot.cpp"
+#include "initialization.cpp"
 
 // Salp Swarm Algorithm (SSA)
 std::pair<std::vector<double>, double> ssa(int num_salps, int max_iter, const std::vector<std::pair<double, double>>& search_space,
-                                           double (*benchmark_function)(const std::vector<double>&)) {
+                                           const Objective& benchmark_function, RunSnapshots* snapshots = nullptr) {
     int num_dimensions = search_space.size();
     std::vector<std::vector<double>> salps(num_salps, std::vector<double>(num_dimensions));
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
+    std::vector<double> fitness(num_salps);
+    auto state = [&](SnapshotArchive& archive) {
+        archive.field(salps);
+        archive.field(fitness);
+    };
+    int t = 0;
+    bool solved = false;
 
-    // Initialize salp positions randomly within the search space
-    for (int i = 0; i < num_salps; ++i) {
-        for (int j = 0; j < num_dimensions; ++j) {
-            salps[i][j] = search_space[j].first + (search_space[j].second - search_space[j].first) * static_cast<double>(std::rand()) / RAND_MAX;
-        }
-    }
+    if (!restore_snapshot(snapshots, "SSA", t, state)) {
+        // Initial salp positions within the search space (initialization.cpp)
+        initialize_population(salps, search_space);
 
-    // Calculate fitness for each salp
-    std::vector<double> fitness(num_salps);
-    for (int i = 0; i < num_salps; ++i) {
-        fitness[i] = benchmark_function(salps[i]);
+        // Calculate fitness for each salp
+        for (int i = 0; i < num_salps; ++i) {
+            fitness[i] = benchmark_function(salps[i]);
+        }
+        solved = target_reached(*std::min_element(fitness.begin(), fitness.end()));
     }
 
-    for (int t = 0; t < max_iter; ++t) {
+    for (; t < max_iter && !solved; ++t) {
+        checkpoint_snapshot(snapshots, "SSA", t, state);
         // Get the best salp
         int best_index = std::distance(fitness.begin(), std::min_element(fitness.begin(), fitness.end()));
         std::vector<double> best_salp = salps[best_index];
@@ -44,7 +54,7 @@ std::pair<std::vector<double>, double> ssa(int num_salps, int max_iter, const st
 
                     // Introduce randomization for the latter half of iterations
                     if (t > max_iter / 2) {
-                        salps[i][j] += w * (2.0 * static_cast<double>(std::rand()) / RAND_MAX - 1.0); // random value in [-1,1]
+                        salps[i][j] += w * (2.0 * randomUnit() - 1.0); // random value in [-1,1]
                     }
 
                     // Boundary check
@@ -57,13 +67,13 @@ std::pair<std::vector<double>, double> ssa(int num_salps, int max_iter, const st
             }
         }
 
-        // Update fitness values
+        // Update fitness values; the salps not evaluated after a hit keep older, worse values
         for (int i = 0; i < num_salps; ++i) {
             fitness[i] = benchmark_function(salps[i]);
-        }
-
-        if (*std::min_element(fitness.begin(), fitness.end()) < 1e-9) {
-            break;
+            if (target_reached(fitness[i])) {
+                solved = true;
+                break;
+            }
         }
     }
 
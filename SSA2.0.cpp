@@ -5,6 +5,8 @@
 #include <numeric>
 #include <ctime>
 #include "benchmarks.h"
+#include "termination.cpp"
+#include "metrics.cpp"
 #include <fstream>
 
 // Salp Swarm Algorithm (SSA)
@@ -15,6 +17,8 @@ std::pair<std::vector<double>, double> ssa(int num_salps, int max_iter, const st
     std::srand(static_cast<unsigned>(std::time(nullptr)));
 
     std::ofstream log_file("results.txt", std::ios_base::app);
+    RunProgress progress("SSA", benchmark_number);
+    uint64_t evaluations = 0;
 
     // Initialize salp positions randomly within the search space
     for (int i = 0; i < num_salps; ++i) {
@@ -27,16 +31,19 @@ std::pair<std::vector<double>, double> ssa(int num_salps, int max_iter, const st
     std::vector<double> fitness(num_salps);
     for (int i = 0; i < num_salps; ++i) {
         fitness[i] = benchmark_function(salps[i]);
+        ++evaluations;
     }
+    // Best value seen so far, for the progress; fitness itself is overwritten and may get worse
+    double best_seen = *std::min_element(fitness.begin(), fitness.end());
+    bool solved = target_reached(best_seen);
 
-    for (int t = 0; t < max_iter; ++t) {
+    for (int t = 0; t < max_iter && !solved; ++t) {
         // Get the best salp
         int best_index = std::distance(fitness.begin(), std::min_element(fitness.begin(), fitness.end()));
         std::vector<double> best_salp = salps[best_index];
 
         // Update positions with adaptive parameter
         double w = 1.0 - (static_cast<double>(t) / max_iter);
-        double best_current_fitness = *std::min_element(fitness.begin(), fitness.end());
         for (int i = 0; i < num_salps; ++i) {
             for (int j = 0; j < num_dimensions; ++j) {
                 if (i == 0) {
@@ -58,26 +65,32 @@ std::pair<std::vector<double>, double> ssa(int num_salps, int max_iter, const st
                     }
                 }
                 fitness[i] = benchmark_function(salps[i]);
+                ++evaluations;
             }
 
-            double current_best_fitness = *std::min_element(fitness.begin(), fitness.end());
-            std::cout << "\rBenchmark " << benchmark_number << ", Iteration " << t << ": Best Fitness = " << std::setprecision(5) << current_best_fitness << std::flush;
-            log_file << "Benchmark " << benchmark_number << ", Iteration " << t << ": Best Fitness = " << std::setprecision(5) << current_best_fitness << std::endl;
+            // Only fitness[i] changed, the others were checked against the target when they were set
+            best_seen = std::min(best_seen, fitness[i]);
+            progress.report(t, evaluations, best_seen);
 
-            if (*std::min_element(fitness.begin(), fitness.end()) < 1e-9) {
+            if (target_reached(fitness[i])) {
+                solved = true;
                 break;
             }
         }
+        log_file << "Benchmark " << benchmark_number << ", Iteration " << t << ": Best Fitness = " << std::setprecision(5)
+                 << *std::min_element(fitness.begin(), fitness.end()) << '\n';
+        if (solved) break;
 
         // Update fitness values
         for (int i = 0; i < num_salps; ++i) {
             fitness[i] = benchmark_function(salps[i]);
+            ++evaluations;
+            best_seen = std::min(best_seen, fitness[i]);
+            if (target_reached(fitness[i])) {
+                solved = true;
+                break;
+            }
         }
-
-        if (*std::min_element(fitness.begin(), fitness.end()) < 1e-9) {
-            break;
-        }
-
     }
 
     log_file.close();
@@ -1,3 +1,4 @@
+#pragma once
 #include <iostream>
 #include <vector>
 #include <algorithm>
@@ -5,6 +6,10 @@
 #include <numeric>
 #include <ctime>
 #include "benchmarks.h"
+#include "random.cpp"
+#include "termination.cpp"
+#include "snapshot.cpp"
+#include "initialization.cpp"
 
 #include <vector>
 #include <algorithm>
@@ -42,37 +47,33 @@ std::vector<double> calculateDifferenceRand(const std::vector<double>& a, const
     return diff;
 }
 
-int getRandomIndex(int max_val) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, max_val - 1);
-    return dis(gen);
-}
-
 // Главная функция TLBO
 std::pair<std::vector<double>, double> tlbo(int num_students, int max_iter,
                                             const std::vector<std::pair<double, double>>& search_space,
-                                            double (*benchmark_function)(const std::vector<double>&)) {
+                                            const Objective& benchmark_function, RunSnapshots* snapshots = nullptr) {
 
     int num_features = search_space.size();
-
-    // Инициализация студентов (population) в пределах заданного пространства поиска
     std::vector<std::vector<double>> students(num_students, std::vector<double>(num_features));
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    for (int i = 0; i < num_students; ++i) {
-        for (int j = 0; j < num_features; ++j) {
-            std::uniform_real_distribution<> dis(search_space[j].first, search_space[j].second);
-            students[i][j] = dis(gen);
-        }
-    }
-
     std::vector<double> fitness(num_students);
-    for (int i = 0; i < num_students; ++i) {
-        fitness[i] = benchmark_function(students[i]);
+    auto state = [&](SnapshotArchive& archive) {
+        archive.field(students);
+        archive.field(fitness);
+    };
+    int h = 0;
+    bool solved = false;
+
+    if (!restore_snapshot(snapshots, "TLBO", h, state)) {
+        // Инициализация студентов (population) в пределах заданного пространства поиска
+        initialize_population(students, search_space);
+
+        for (int i = 0; i < num_students; ++i) {
+            fitness[i] = benchmark_function(students[i]);
+        }
+        solved = target_reached(*std::min_element(fitness.begin(), fitness.end()));
     }
 
-    for (int h = 0; h < max_iter; ++h) {
+    for (; h < max_iter && !solved; ++h) {
+        checkpoint_snapshot(snapshots, "TLBO", h, state);
         // Стадия учителя
         int best_index = std::distance(fitness.begin(), std::min_element(fitness.begin(), fitness.end()));
         std::vector<double> teacher = students[best_index];
@@ -90,8 +91,13 @@ std::pair<std::vector<double>, double> tlbo(int num_students, int max_iter,
                     students[i] = difference;
                     fitness[i] = new_score;
                 }
+                if (target_reached(new_score)) {
+                    solved = true;
+                    break;
+                }
             }
         }
+        if (solved) break;
 
         // Стадия ученика
         for (int i = 0; i < num_students; i++) {
@@ -113,6 +119,10 @@ std::pair<std::vector<double>, double> tlbo(int num_students, int max_iter,
                 students[i] = new_student;
                 fitness[i] = new_score;
             }
+            if (target_reached(new_score)) {
+                solved = true;
+                break;
+            }
         }
     }
 
@@ -4,13 +4,9 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
-
-
-double getRandomValue(double min, double max) {
-    static std::default_random_engine generator;
-    std::uniform_real_distribution<double> distribution(min, max);
-    return distribution(generator);
-}
+#include "random.cpp"
+#include "termination.cpp"
+#include "metrics.cpp"
 
 
 std::pair<std::vector<double>, double> woa(int num_agents, int max_iter, const std::vector<std::pair<double, double>>& search_space,
@@ -18,6 +14,8 @@ std::pair<std::vector<double>, double> woa(int num_agents, int max_iter, const s
     int num_features = search_space.size();
     std::vector<std::vector<double>> agents(num_agents, std::vector<double>(num_features));
     std::ofstream log_file("results.txt", std::ios_base::app);
+    RunProgress progress("WOA", benchmark_number);
+    uint64_t evaluations = 0;
     std::srand(static_cast<unsigned>(std::time(nullptr)));
 
     for(int i = 0; i < num_agents; i++) {
@@ -30,9 +28,13 @@ std::pair<std::vector<double>, double> woa(int num_agents, int max_iter, const s
 
     for(int i = 0; i < num_agents; i++) {
         fitness[i] = benchmark_function(agents[i]);
+        ++evaluations;
     }
+    // Agents are only replaced by better points, so the best is a running minimum
+    double best_fitness = *std::min_element(fitness.begin(), fitness.end());
+    bool solved = target_reached(best_fitness);
 
-    for (int t = 0; t < max_iter; t++) {
+    for (int t = 0; t < max_iter && !solved; t++) {
         double a = 2.0 - t * ((2.0) / max_iter);
 
         for(int i = 0; i < num_agents; i++) {
@@ -75,18 +77,20 @@ std::pair<std::vector<double>, double> woa(int num_agents, int max_iter, const s
             }
 
             double new_fitness = benchmark_function(X_new);
+            ++evaluations;
             if(new_fitness < fitness[i]) {
                 agents[i] = X_new;
                 fitness[i] = new_fitness;
+                best_fitness = std::min(best_fitness, new_fitness);
             }
-            double current_best_fitness = *std::min_element(fitness.begin(), fitness.end());
-            std::cout << "\rBenchmark " << benchmark_number << ", Iteration " << t << ": Best Fitness = " << std::setprecision(5) << current_best_fitness << std::flush;
-            log_file << "Benchmark " << benchmark_number << ", Iteration " << t << ": Best Fitness = " << std::setprecision(5) << current_best_fitness << std::endl;
+            progress.report(t, evaluations, best_fitness);
 
-            if (*std::min_element(fitness.begin(), fitness.end()) < 1e-9) {
+            if (target_reached(best_fitness)) {
+                solved = true;
                 break;
             }
         }
+        log_file << "Benchmark " << benchmark_number << ", Iteration " << t << ": Best Fitness = " << std::setprecision(5) << best_fitness << '\n';
     }
 
     log_file.close();
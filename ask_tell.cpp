@@ -0,0 +1,318 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include "benchmarks.h"
+#include "random.cpp"
+#include "AOA.cpp"
+#include "TLBO.cpp"
+#include "SSA.cpp"
+#include "termination.cpp"
+#include "initialization.cpp"
+
+// Optimizers in ask/tell form: ask() proposes a candidate for one agent from the current
+// population, tell() applies the greedy replacement of the original algorithm. Drivers decide
+// when and where the candidates are evaluated (steady_state.cpp, surrogate.cpp).
+
+struct Candidate {
+    int agent;
+    std::vector<double> position;
+};
+
+class AskTellOptimizer {
+public:
+    AskTellOptimizer(int num_agents, int max_iter, const std::vector<std::pair<double, double>>& search_space)
+        : num_agents(num_agents), max_iter(max_iter), search_space(search_space),
+          agents(num_agents, std::vector<double>(search_space.size())),
+          fitness(num_agents, std::numeric_limits<double>::infinity()), busy(num_agents, false) {}
+
+    virtual ~AskTellOptimizer() = default;
+
+    // Next candidate for an agent without a pending evaluation; false if all agents are busy or
+    // the run is finished. The first num_agents candidates are the initial population.
+    bool ask(Candidate& candidate) {
+        for (int k = 0; k < num_agents && !finished(); ++k) {
+            int i = (next_agent + k) % num_agents;
+            if (busy[i]) continue;
+            if (initialized < num_agents && i != initialized) continue;
+
+            candidate.agent = i;
+            candidate.position.resize(search_space.size());
+            next_agent = (i + 1) % num_agents;
+            if (initialized < num_agents) {
+                if (initialized == 0) {
+                    initial.resize(num_agents * search_space.size());
+                    initialize_population(initial.data(), num_agents, search_space);
+                }
+                const double* row = &initial[initialized * search_space.size()];
+                std::copy(row, row + search_space.size(), candidate.position.begin());
+                if (++initialized == num_agents) std::vector<double>().swap(initial);
+            } else {
+                // Agents the algorithm leaves alone in this step still use up their proposal
+                bool proposed = propose(i, candidate.position);
+                ++proposals;
+                if (!proposed) continue;
+            }
+            busy[i] = true;
+            return true;
+        }
+        return false;
+    }
+
+    void tell(const Candidate& candidate, double value) {
+        busy[candidate.agent] = false;
+        ++evaluations;
+        if (target_reached(value)) solved = true; // target of the thread that calls tell()
+        if (value < fitness[candidate.agent]) {
+            agents[candidate.agent] = candidate.position;
+            fitness[candidate.agent] = value;
+        }
+    }
+
+    // Drops a candidate without evaluating it (e.g. rejected by a surrogate)
+    void discard(const Candidate& candidate) {
+        busy[candidate.agent] = false;
+    }
+
+    // Takes over a position found elsewhere (portfolio.cpp): it replaces the worst agent without a
+    // pending evaluation if it is better. False if nothing was replaced.
+    bool adopt(const std::vector<double>& position, double value) {
+        if (initialized < num_agents) return false;
+        int worst = -1;
+        for (int i = 0; i < num_agents; ++i)
+            if (!busy[i] && (worst < 0 || fitness[i] > fitness[worst])) worst = i;
+        if (worst < 0 || !(value < fitness[worst])) return false;
+        agents[worst] = position;
+        fitness[worst] = value;
+        return true;
+    }
+
+    // Iteration the generational algorithm would be in after the same number of proposals, or at
+    // the progress set with setProgress()
+    int iteration() const {
+        if (progress >= 0.0) return std::min(static_cast<int>(progress * max_iter), max_iter - 1);
+        return static_cast<int>(std::min<long long>(proposals / (static_cast<long long>(num_agents) * phases()), max_iter - 1));
+    }
+
+    // Lets the iteration-dependent coefficients follow an outside clock, e.g. the share of a
+    // budget the optimizer shares with others (portfolio.cpp); fraction in [0, 1]
+    void setProgress(double fraction) { progress = fraction; }
+
+    // Budget spent or target reached; candidates already handed out may still be told
+    bool finished() const {
+        return solved || (initialized == num_agents && proposals >= static_cast<long long>(num_agents) * phases() * max_iter);
+    }
+
+    int agentCount() const { return num_agents; }
+    long long evaluationCount() const { return evaluations; }
+    double agentFitness(int i) const { return fitness[i]; }
+
+    std::pair<std::vector<double>, double> best() const {
+        int best_index = std::distance(fitness.begin(), std::min_element(fitness.begin(), fitness.end()));
+        return {agents[best_index], fitness[best_index]};
+    }
+
+protected:
+    // Writes the candidate of agent i; false if the agent has no candidate in this step
+    virtual bool propose(int i, std::vector<double>& position) = 0;
+
+    // Proposals per agent and iteration (TLBO: teacher and learner phase)
+    virtual int phases() const { return 1; }
+
+    // Index of the current proposal inside its iteration, 0 .. num_agents * phases() - 1
+    long long stepInIteration() const { return proposals % (static_cast<long long>(num_agents) * phases()); }
+
+    int num_agents;
+    int max_iter;
+    std::vector<std::pair<double, double>> search_space;
+    std::vector<std::vector<double>> agents;
+    std::vector<double> fitness;
+
+private:
+    std::vector<bool> busy;
+    int next_agent = 0;
+    int initialized = 0;
+    std::vector<double> initial; // N x D initial population until it has been asked
+    long long proposals = 0;
+    long long evaluations = 0;
+    bool solved = false;
+    double progress = -1.0; // < 0: follow the own proposals
+};
+
+// WOA step of woa() for agent i
+class WoaAskTell : public AskTellOptimizer {
+public:
+    using AskTellOptimizer::AskTellOptimizer;
+
+protected:
+    bool propose(int i, std::vector<double>& X_new) override {
+        int num_features = search_space.size();
+        double a = 2.0 - iteration() * ((2.0) / max_iter);
+        double r1 = getRandomValue(0, 1);
+        double r2 = getRandomValue(0, 1);
+        double A = 2.0 * a * r1 - a;
+        double C = 2.0 * r2;
+        double b = 1;
+        double l = (getRandomValue(0, 1) * 2) - 1;
+        double p = getRandomValue(0, 1);
+        const std::vector<double>& X_rand = agents[static_cast<int>(getRandomValue(0, num_agents - 1))];
+
+        for (int j = 0; j < num_features; j++) {
+            if (p < 0.5)
+                X_new[j] = X_rand[j] - A * std::fabs(C * X_rand[j] - agents[i][j]);
+            else
+                X_new[j] = std::fabs(X_rand[j] - agents[i][j]) * std::exp(b * l) * std::cos(2 * M_PI * l) + X_rand[j];
+            X_new[j] = std::clamp(X_new[j], search_space[j].first, search_space[j].second);
+        }
+        return true;
+    }
+};
+
+// SCA step of sca() for agent i
+class ScaAskTell : public AskTellOptimizer {
+public:
+    using AskTellOptimizer::AskTellOptimizer;
+
+protected:
+    bool propose(int i, std::vector<double>& new_position) override {
+        double a_t = 2.0 - double(iteration()) * (2.0 / double(max_iter));
+        double r1 = getRandomValue(0, 1);
+        double r2 = getRandomValue(0, 1);
+        double A = 2 * a_t * r1 - a_t;
+        double C = 2 * r2;
+
+        int random_agent_index = getRandomIndex(num_agents);
+        while (random_agent_index == i)
+            random_agent_index = getRandomIndex(num_agents);
+
+        const std::vector<double>& random_agent = agents[random_agent_index];
+        for (size_t j = 0; j < new_position.size(); j++)
+            new_position[j] = random_agent[j] + A * C * (random_agent[j] - agents[i][j]);
+        return true;
+    }
+};
+
+// AOA step of aoa() for agent i
+class AoaAskTell : public AskTellOptimizer {
+public:
+    using AskTellOptimizer::AskTellOptimizer;
+
+protected:
+    bool propose(int i, std::vector<double>& new_position) override {
+        new_position = updatePosition(agents[i], static_cast<double>(iteration()) / max_iter, search_space);
+        return true;
+    }
+};
+
+// TLBO of tlbo(): a teacher phase and a learner phase per iteration
+class TlboAskTell : public AskTellOptimizer {
+public:
+    using AskTellOptimizer::AskTellOptimizer;
+
+protected:
+    int phases() const override { return 2; }
+
+    bool propose(int i, std::vector<double>& new_student) override {
+        bool teacher_phase = stepInIteration() < num_agents;
+        if (teacher_phase) {
+            // Teacher and class mean are fixed for the whole phase, as in tlbo()
+            if (stepInIteration() == 0) {
+                best_index = std::distance(fitness.begin(), std::min_element(fitness.begin(), fitness.end()));
+                teacher = agents[best_index];
+                students_mean = meanAlongAxis(agents);
+            }
+            if (i == best_index) return false;
+            for (size_t j = 0; j < new_student.size(); j++)
+                new_student[j] = teacher[j] - students_mean[j] + agents[i][j];
+            return true;
+        }
+
+        int random_index_1 = getRandomIndex(num_agents);
+        int random_index_2 = getRandomIndex(num_agents);
+        while (random_index_1 == random_index_2) {
+            random_index_2 = getRandomIndex(num_agents);
+        }
+        if (fitness[random_index_1] < fitness[random_index_2])
+            new_student = calculateDifferenceRand(agents[random_index_1], agents[random_index_2], agents[i]);
+        else
+            new_student = calculateDifferenceRand(agents[random_index_2], agents[random_index_1], agents[i]);
+        return true;
+    }
+
+private:
+    int best_index = 0;
+    std::vector<double> teacher;
+    std::vector<double> students_mean;
+};
+
+// SSA step of ssa() for agent i: the leader (agent 0) goes to the best salp, every follower
+// halfway to the candidate of the salp in front of it. Unlike ssa(), a salp keeps its position
+// when its candidate is worse (greedy, as in the other forms).
+class SsaAskTell : public AskTellOptimizer {
+public:
+    using AskTellOptimizer::AskTellOptimizer;
+
+protected:
+    bool propose(int i, std::vector<double>& position) override {
+        int t = iteration();
+        if (i == 0 || previous.empty()) {
+            position = agents[std::distance(fitness.begin(), std::min_element(fitness.begin(), fitness.end()))];
+        } else {
+            double w = 1.0 - (static_cast<double>(t) / max_iter);
+            for (size_t j = 0; j < position.size(); ++j) {
+                position[j] = (agents[i][j] + previous[j]) / 2;
+                if (t > max_iter / 2) position[j] += w * (2.0 * randomUnit() - 1.0);
+                position[j] = std::clamp(position[j], search_space[j].first, search_space[j].second);
+            }
+        }
+        previous = position;
+        return true;
+    }
+
+private:
+    std::vector<double> previous; // candidate of the salp in front
+};
+
+// ICA step of ica() for agent i. The num_empires best agents at the start of an iteration are
+// the empires: each one is crossed with a random empire with probability 1/2, every other
+// agent (colony) is assimilated towards its empire and disturbed by a revolution.
+// Replacement is greedy.
+class IcaAskTell : public AskTellOptimizer {
+public:
+    IcaAskTell(int num_agents, int max_iter, const std::vector<std::pair<double, double>>& search_space, int num_empires)
+        : AskTellOptimizer(num_agents, max_iter, search_space), num_empires(std::max(1, std::min(num_empires, num_agents))),
+          ranking(num_agents), rank(num_agents) {}
+
+protected:
+    bool propose(int i, std::vector<double>& position) override {
+        if (stepInIteration() == 0) {
+            std::iota(ranking.begin(), ranking.end(), 0);
+            std::sort(ranking.begin(), ranking.end(), [this](int i1, int i2) { return fitness[i1] < fitness[i2]; });
+            for (int k = 0; k < num_agents; ++k) rank[ranking[k]] = k;
+        }
+        double t = iteration();
+        double assimilation_coeff = 0.5 - (0.5 - 0.1) * t / max_iter;
+        double learning_rate = 0.5 - (0.5 - 0.01) * t / max_iter;
+
+        if (rank[i] < num_empires) {
+            if (!(randomUnit() < 0.5)) return false;
+            const std::vector<double>& other = agents[ranking[getRandomIndex(num_empires)]];
+            for (size_t j = 0; j < position.size(); ++j)
+                position[j] = 0.5 * (agents[i][j] + other[j]);
+            return true;
+        }
+        const std::vector<double>& empire = agents[ranking[(rank[i] - num_empires) % num_empires]];
+        for (size_t j = 0; j < position.size(); ++j) {
+            position[j] = agents[i][j] - learning_rate * assimilation_coeff * (agents[i][j] - empire[j]);
+            position[j] += 0.2 * randomUnit();
+        }
+        return true;
+    }
+
+private:
+    int num_empires;
+    std::vector<int> ranking; // agents by fitness at the start of the iteration
+    std::vector<int> rank;
+};
@@ -0,0 +1,276 @@
+// Shared library behind bench_capi.h; the one translation unit of libbench.so:
+//   g++ -std=c++17 -O2 -shared -fPIC -fvisibility=hidden bench_capi.cpp -o libbench.so -pthread
+// Only the bench_* functions are exported, so the library's copies of the benchmark and optimizer
+// code do not clash with a caller that includes the same sources itself.
+#define BENCH_CAPI_BUILD
+#include "bench_capi.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <limits>
+#include <algorithm>
+#include <exception>
+#include "benchmarks.h"
+#include "registry.cpp"
+#include "random.cpp"
+#include "noise.cpp"
+#include "termination.cpp"
+#include "ask_tell.cpp"
+
+static_assert(unsigned(BENCH_CAP_BATCH) == CapBatch && unsigned(BENCH_CAP_SIMD) == CapSimd &&
+                  unsigned(BENCH_CAP_DELTA) == CapDelta && unsigned(BENCH_CAP_SEPARABLE) == CapSeparable &&
+                  unsigned(BENCH_CAP_NOISY) == CapNoisy,
+              "capability bits of bench_capi.h and registry.cpp differ");
+
+struct bench_optimizer {
+    std::mutex mutex;
+    std::unique_ptr<AskTellOptimizer> optimizer;
+    size_t dims;
+    RandomEngine random;
+    RunControl control;
+    std::vector<Candidate> pending; // asked, not yet told
+    std::vector<double> block;      // contiguous population of bench_optimizer_step
+    std::vector<double> values;
+};
+
+namespace {
+
+thread_local std::string last_error;
+
+int fail(int code, const std::string& message) {
+    last_error = message;
+    return code;
+}
+
+// Exceptions do not cross the C boundary
+template <typename Body>
+int guarded(const Body& body) {
+    try {
+        last_error.clear();
+        return body();
+    } catch (const std::exception& error) {
+        return fail(BENCH_ERR_INTERNAL, error.what());
+    } catch (...) {
+        return fail(BENCH_ERR_INTERNAL, "unknown exception");
+    }
+}
+
+void fillInfo(const BenchmarkInfo& benchmark, bench_info* info) {
+    *info = {benchmark.id, benchmark.name, benchmark.lower, benchmark.upper, benchmark.dims, benchmark.optimum,
+             benchmark.optimum_per_dim, benchmark.capabilities()};
+}
+
+// The handle's random stream and run control on the calling thread while it works on the handle
+class HandleScope {
+public:
+    explicit HandleScope(bench_optimizer& handle)
+        : handle(handle), lock(handle.mutex), saved_random(random_engine), saved_control(run_control) {
+        random_engine = handle.random;
+        run_control = handle.control;
+    }
+
+    ~HandleScope() {
+        handle.random = random_engine;
+        handle.control = run_control;
+        random_engine = saved_random;
+        run_control = saved_control;
+    }
+
+private:
+    bench_optimizer& handle;
+    std::lock_guard<std::mutex> lock;
+    RandomEngine saved_random;
+    RunControl saved_control;
+};
+
+std::unique_ptr<AskTellOptimizer> makeOptimizer(const std::string& algorithm, int num_agents, int max_iter,
+                                                const std::vector<std::pair<double, double>>& space) {
+    if (algorithm == "WOA") return std::make_unique<WoaAskTell>(num_agents, max_iter, space);
+    if (algorithm == "SCA") return std::make_unique<ScaAskTell>(num_agents, max_iter, space);
+    if (algorithm == "AOA") return std::make_unique<AoaAskTell>(num_agents, max_iter, space);
+    if (algorithm == "TLBO") return std::make_unique<TlboAskTell>(num_agents, max_iter, space);
+    if (algorithm == "SSA") return std::make_unique<SsaAskTell>(num_agents, max_iter, space);
+    if (algorithm == "ICA") return std::make_unique<IcaAskTell>(num_agents, max_iter, space, std::max(1, std::min(10, num_agents / 2)));
+    return nullptr;
+}
+
+// Candidates for the handle's pending list, at most max_candidates
+size_t askPending(bench_optimizer& handle, size_t max_candidates) {
+    handle.pending.clear();
+    while (handle.pending.size() < max_candidates) {
+        handle.pending.emplace_back();
+        if (!handle.optimizer->ask(handle.pending.back())) {
+            handle.pending.pop_back();
+            break;
+        }
+    }
+    return handle.pending.size();
+}
+
+} // namespace
+
+extern "C" {
+
+int bench_api_version(void) { return BENCH_CAPI_VERSION; }
+
+const char* bench_last_error(void) { return last_error.c_str(); }
+
+size_t bench_count(void) { return benchmark_registry().size(); }
+
+int bench_info_at(size_t index, bench_info* info) {
+    if (!info || index >= benchmark_registry().size()) return fail(BENCH_ERR_ARGUMENT, "index out of range or info is NULL");
+    fillInfo(benchmark_registry()[index], info);
+    return BENCH_OK;
+}
+
+int bench_get_info(int id, bench_info* info) {
+    if (!info) return fail(BENCH_ERR_ARGUMENT, "info is NULL");
+    const BenchmarkInfo* benchmark = find_benchmark(id);
+    if (!benchmark) return fail(BENCH_ERR_UNKNOWN, "no benchmark f" + std::to_string(id));
+    fillInfo(*benchmark, info);
+    return BENCH_OK;
+}
+
+int bench_find(const char* name) {
+    if (!name) return fail(BENCH_ERR_ARGUMENT, "name is NULL");
+    return guarded([name]() -> int {
+        const BenchmarkInfo* benchmark = find_benchmark(std::string(name));
+        return benchmark ? benchmark->id : fail(BENCH_ERR_UNKNOWN, std::string("no benchmark ") + name);
+    });
+}
+
+int bench_evaluate(int id, const double* positions, size_t n, size_t dims, size_t row_stride, double* fitness,
+                   size_t fitness_stride) {
+    if (!positions || !fitness || dims == 0 || row_stride < dims || fitness_stride == 0)
+        return fail(BENCH_ERR_ARGUMENT, "bad buffers or strides");
+    const BenchmarkInfo* benchmark = find_benchmark(id);
+    if (!benchmark) return fail(BENCH_ERR_UNKNOWN, "no benchmark f" + std::to_string(id));
+    return guarded([&]() -> int {
+        if (row_stride == dims && fitness_stride == 1) {
+            evaluate_population(*benchmark, positions, n, dims, fitness);
+            return BENCH_OK;
+        }
+        // Strided buffers: gathered block by block into a contiguous scratch population
+        const size_t block_rows = 256;
+        thread_local std::vector<double> block, values;
+        block.resize(block_rows * dims);
+        values.resize(block_rows);
+        for (size_t first = 0; first < n; first += block_rows) {
+            size_t rows = std::min(block_rows, n - first);
+            for (size_t r = 0; r < rows; ++r)
+                std::copy(positions + (first + r) * row_stride, positions + (first + r) * row_stride + dims, &block[r * dims]);
+            evaluate_population(*benchmark, block.data(), rows, dims, values.data());
+            for (size_t r = 0; r < rows; ++r) fitness[(first + r) * fitness_stride] = values[r];
+        }
+        return BENCH_OK;
+    });
+}
+
+void bench_seed_noise(uint64_t seed) { seed_noise(seed); }
+
+bench_optimizer* bench_optimizer_create(const char* algorithm, int num_agents, int max_iter, size_t dims, const double* lower,
+                                        const double* upper, uint64_t seed) {
+    if (!algorithm || num_agents < 2 || max_iter < 1 || dims == 0 || !lower || !upper) {
+        fail(BENCH_ERR_ARGUMENT, "bad algorithm, sizes or bounds");
+        return nullptr;
+    }
+    bench_optimizer* handle = nullptr;
+    guarded([&]() -> int {
+        std::vector<std::pair<double, double>> space(dims);
+        for (size_t j = 0; j < dims; ++j) {
+            if (!(lower[j] <= upper[j])) return fail(BENCH_ERR_ARGUMENT, "lower bound above upper bound");
+            space[j] = {lower[j], upper[j]};
+        }
+        std::unique_ptr<AskTellOptimizer> optimizer = makeOptimizer(algorithm, num_agents, max_iter, space);
+        if (!optimizer) return fail(BENCH_ERR_UNKNOWN, std::string("no algorithm ") + algorithm);
+        handle = new bench_optimizer();
+        handle->optimizer = std::move(optimizer);
+        handle->dims = dims;
+        handle->random.seed(seed);
+        return BENCH_OK;
+    });
+    return handle;
+}
+
+void bench_optimizer_destroy(bench_optimizer* optimizer) { delete optimizer; }
+
+int bench_optimizer_set_target(bench_optimizer* optimizer, double target) {
+    if (!optimizer) return fail(BENCH_ERR_ARGUMENT, "optimizer is NULL");
+    std::lock_guard<std::mutex> lock(optimizer->mutex);
+    optimizer->control.target = target;
+    return BENCH_OK;
+}
+
+int bench_optimizer_ask(bench_optimizer* optimizer, double* positions, size_t max_candidates, size_t row_stride) {
+    if (!optimizer || !positions || row_stride < (optimizer ? optimizer->dims : 0))
+        return fail(BENCH_ERR_ARGUMENT, "bad optimizer, buffer or stride");
+    return guarded([&]() -> int {
+        HandleScope scope(*optimizer);
+        if (!optimizer->pending.empty()) return fail(BENCH_ERR_STATE, "candidates of the last ask are not told yet");
+        size_t count = askPending(*optimizer, std::min<size_t>(max_candidates, std::numeric_limits<int>::max()));
+        for (size_t c = 0; c < count; ++c)
+            std::copy(optimizer->pending[c].position.begin(), optimizer->pending[c].position.end(), positions + c * row_stride);
+        return static_cast<int>(count);
+    });
+}
+
+int bench_optimizer_tell(bench_optimizer* optimizer, const double* fitness, size_t count, size_t fitness_stride) {
+    if (!optimizer || (!fitness && count > 0) || fitness_stride == 0) return fail(BENCH_ERR_ARGUMENT, "bad optimizer, buffer or stride");
+    return guarded([&]() -> int {
+        HandleScope scope(*optimizer);
+        if (count != optimizer->pending.size())
+            return fail(BENCH_ERR_STATE, "told " + std::to_string(count) + " values for " + std::to_string(optimizer->pending.size()) +
+                                             " candidates");
+        for (size_t c = 0; c < count; ++c) optimizer->optimizer->tell(optimizer->pending[c], fitness[c * fitness_stride]);
+        optimizer->pending.clear();
+        return BENCH_OK;
+    });
+}
+
+int bench_optimizer_step(bench_optimizer* optimizer, int id, int generations) {
+    if (!optimizer || generations < 0) return fail(BENCH_ERR_ARGUMENT, "bad optimizer or generations");
+    const BenchmarkInfo* benchmark = find_benchmark(id);
+    if (!benchmark) return fail(BENCH_ERR_UNKNOWN, "no benchmark f" + std::to_string(id));
+    return guarded([&]() -> int {
+        HandleScope scope(*optimizer);
+        if (!optimizer->pending.empty()) return fail(BENCH_ERR_STATE, "candidates of the last ask are not told yet");
+        size_t dims = optimizer->dims;
+        int rounds = 0;
+        for (; rounds < generations; ++rounds) {
+            size_t count = askPending(*optimizer, std::numeric_limits<int>::max());
+            if (count == 0) break;
+            optimizer->block.resize(count * dims);
+            optimizer->values.resize(count);
+            for (size_t c = 0; c < count; ++c)
+                std::copy(optimizer->pending[c].position.begin(), optimizer->pending[c].position.end(), &optimizer->block[c * dims]);
+            evaluate_population(*benchmark, optimizer->block.data(), count, dims, optimizer->values.data());
+            for (size_t c = 0; c < count; ++c) optimizer->optimizer->tell(optimizer->pending[c], optimizer->values[c]);
+            optimizer->pending.clear();
+        }
+        return rounds;
+    });
+}
+
+int bench_optimizer_finished(bench_optimizer* optimizer) {
+    if (!optimizer) return fail(BENCH_ERR_ARGUMENT, "optimizer is NULL");
+    std::lock_guard<std::mutex> lock(optimizer->mutex);
+    return optimizer->optimizer->finished() ? 1 : 0;
+}
+
+uint64_t bench_optimizer_evaluations(bench_optimizer* optimizer) {
+    if (!optimizer) return fail(BENCH_ERR_ARGUMENT, "optimizer is NULL"), 0;
+    std::lock_guard<std::mutex> lock(optimizer->mutex);
+    return optimizer->optimizer->evaluationCount();
+}
+
+double bench_optimizer_best(bench_optimizer* optimizer, double* position) {
+    if (!optimizer) return fail(BENCH_ERR_ARGUMENT, "optimizer is NULL"), std::numeric_limits<double>::quiet_NaN();
+    std::lock_guard<std::mutex> lock(optimizer->mutex);
+    auto [best_position, value] = optimizer->optimizer->best();
+    if (position) std::copy(best_position.begin(), best_position.end(), position);
+    return value;
+}
+
+} // extern "C"
@@ -0,0 +1,108 @@
+#pragma once
+// C interface of the benchmark functions f1..f19 and the ask/tell optimizers, for use from
+// other languages and services through a shared library:
+//
+//     g++ -std=c++17 -O2 -shared -fPIC -fvisibility=hidden bench_capi.cpp -o libbench.so -pthread
+//
+// Buffers belong to the caller and are read or written in place. A population is N rows of D
+// doubles; consecutive rows start row_stride doubles apart (row_stride >= D), consecutive
+// fitness values fitness_stride doubles apart. Contiguous buffers (row_stride == D,
+// fitness_stride == 1) go to the batch kernels without a copy.
+//
+// All functions may be called from any number of threads at once. Random streams, noise
+// streams (f7) and error messages belong to the calling thread; an optimizer handle carries its
+// own random stream and target and may be used from any thread (calls on one handle are
+// serialized). Functions return BENCH_OK (0) or a negative BENCH_ERR_* code unless stated
+// otherwise; bench_last_error() describes the last failure on the calling thread.
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(BENCH_CAPI_BUILD) && defined(__GNUC__)
+#define BENCH_API __attribute__((visibility("default")))
+#else
+#define BENCH_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BENCH_CAPI_VERSION 1
+
+enum {
+    BENCH_OK = 0,
+    BENCH_ERR_ARGUMENT = -1, // null pointer, zero size, stride smaller than D, bad bounds
+    BENCH_ERR_UNKNOWN = -2,  // no such benchmark or algorithm
+    BENCH_ERR_STATE = -3,    // ask/tell out of order
+    BENCH_ERR_INTERNAL = -4  // unexpected failure, see bench_last_error()
+};
+
+// Capability bits of bench_info.capabilities
+enum {
+    BENCH_CAP_BATCH = 1 << 0,     // population kernel
+    BENCH_CAP_SIMD = 1 << 1,      // the kernel is vectorized
+    BENCH_CAP_DELTA = 1 << 2,     // one-coordinate updates without a full evaluation
+    BENCH_CAP_SEPARABLE = 1 << 3, // sum of per-coordinate terms
+    BENCH_CAP_NOISY = 1 << 4      // value contains noise (f7)
+};
+
+typedef struct bench_info {
+    int id;                 // n of the f-function
+    const char* name;       // static string
+    double lower, upper;    // default bounds of every coordinate
+    size_t default_dims;
+    double optimum;         // at D dimensions: optimum + optimum_per_dim * D; NaN if unknown
+    double optimum_per_dim;
+    unsigned capabilities;  // BENCH_CAP_*
+} bench_info;
+
+BENCH_API int bench_api_version(void);
+
+// Message of the last failed call on this thread ("" if none)
+BENCH_API const char* bench_last_error(void);
+
+// Benchmarks: index 0 .. bench_count() - 1 in registry order
+BENCH_API size_t bench_count(void);
+BENCH_API int bench_info_at(size_t index, bench_info* info);
+BENCH_API int bench_get_info(int id, bench_info* info);
+// Id of a benchmark by name or label ("rastrigin", "f9"); BENCH_ERR_UNKNOWN if none
+BENCH_API int bench_find(const char* name);
+
+// fitness[i * fitness_stride] = f_id(positions + i * row_stride), i < n
+BENCH_API int bench_evaluate(int id, const double* positions, size_t n, size_t dims, size_t row_stride,
+                             double* fitness, size_t fitness_stride);
+
+// Noise stream of f7 on the calling thread
+BENCH_API void bench_seed_noise(uint64_t seed);
+
+// Optimizers: "WOA", "SCA", "AOA", "TLBO", "SSA", "ICA" in ask/tell form.
+// max_iter iterations of num_agents agents; lower/upper hold D bounds each. NULL on failure.
+typedef struct bench_optimizer bench_optimizer;
+
+BENCH_API bench_optimizer* bench_optimizer_create(const char* algorithm, int num_agents, int max_iter, size_t dims,
+                                                  const double* lower, const double* upper, uint64_t seed);
+BENCH_API void bench_optimizer_destroy(bench_optimizer* optimizer);
+
+// Stop as soon as a value <= target is told (default: -infinity, run the whole budget)
+BENCH_API int bench_optimizer_set_target(bench_optimizer* optimizer, double target);
+
+// Writes up to max_candidates candidates (rows of D) to positions and returns how many; 0 when
+// the run is finished. Every asked candidate must be told before the next ask.
+BENCH_API int bench_optimizer_ask(bench_optimizer* optimizer, double* positions, size_t max_candidates, size_t row_stride);
+
+// Values of the candidates of the last ask, in order; count must equal their number
+BENCH_API int bench_optimizer_tell(bench_optimizer* optimizer, const double* fitness, size_t count, size_t fitness_stride);
+
+// Runs up to generations ask/evaluate/tell rounds on benchmark id; returns the rounds run
+BENCH_API int bench_optimizer_step(bench_optimizer* optimizer, int id, int generations);
+
+// 1 finished, 0 running, < 0 error
+BENCH_API int bench_optimizer_finished(bench_optimizer* optimizer);
+BENCH_API uint64_t bench_optimizer_evaluations(bench_optimizer* optimizer);
+
+// Best value so far; its position is copied to position (D doubles) unless NULL
+BENCH_API double bench_optimizer_best(bench_optimizer* optimizer, double* position);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,6 +8,8 @@
 #include <chrono>
 #include <functional>
 #include "benchmarks.h"
+#include "noise.cpp"
+#include "simd.cpp"
 
 #ifndef M_PI
 const double M_PI = 3.14159265358979323846;
@@ -42,28 +44,58 @@ double f4(const std::vector<double>& position) {
     return *std::max_element(position.begin(), position.end(), [](double a, double b) { return std::abs(a) < std::abs(b); });
 }
 
-double f5(const std::vector<double>& position) {
+// f5 and f6 on a raw array, squares as products (std::pow(x, 2) rounds the same)
+double rosenbrock_kernel(const double* x, size_t n) {
+    double result = 0.0;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        double a = x[i + 1] - x[i] * x[i];
+        double b = x[i] - 1.0;
+        result += 100.0 * (a * a) + b * b;
+    }
+    return result;
+}
+
+double step_kernel(const double* x, size_t n) {
     double result = 0.0;
-    for (size_t i = 0; i < position.size() - 1; ++i) {
-        double term1 = 100.0 * std::pow((position[i + 1] - position[i] * position[i]), 2);
-        double term2 = std::pow((position[i] - 1.0), 2);
-        result += term1 + term2;
+    for (size_t i = 0; i < n; ++i) {
+        double r = std::round(x[i] + 0.5);
+        result += r * r;
     }
     return result;
 }
 
+double f5(const std::vector<double>& position) {
+    return rosenbrock_kernel(position.data(), position.size());
+}
+
 double f6(const std::vector<double>& position) {
-    return std::accumulate(position.begin(), position.end(), 0.0, [](double a, double b) { return a + std::pow(std::round(b + 0.5), 2); });
+    return step_kernel(position.data(), position.size());
 }
 
-double f7(const std::vector<double>& position) {
+// f7 = quartic part + one uniform [0, 1) draw per coordinate
+double f7_quartic(const std::vector<double>& position) {
+    double result = 0.0;
+    for (size_t i = 0; i < position.size(); ++i) {
+        result += (i + 1) * std::pow(position[i], 4);
+    }
+    return result;
+}
+
+double f7_noise(const std::vector<double>& position, NoiseStream& stream) {
     double result = 0.0;
     for (size_t i = 0; i < position.size(); ++i) {
-        result += (i + 1) * std::pow(position[i], 4) + ((double)rand() / RAND_MAX);
+        result += stream.next();
     }
     return result;
 }
 
+const NoisyBenchmark f7_noisy = {f7_quartic, f7_noise};
+
+double f7(const std::vector<double>& position) {
+    NoiseStream stream = next_noise_stream();
+    return f7_quartic(position) + f7_noise(position, stream);
+}
+
 double f8(const std::vector<double>& position) {
     return std::accumulate(position.begin(), position.end(), 0.0, [](double a, double b) { return a - b * std::sin(std::sqrt(std::abs(b))); });
 }
@@ -90,25 +122,63 @@ double u(double x, double a, double k, double m) {
     else return 0.0;
 }
 
-double f12(const std::vector<double>& position) {
-    std::vector<double> y(position.size());
-    std::transform(position.begin(), position.end(), y.begin(), [](double xi) { return 1.0 + (xi + 1.0) / 4.0; });
+// Sum of u(x[i], a, k, 4) without branches: d = max(x - a, 0) + max(-x - a, 0) is the distance
+// outside [-a, a] (at most one of the two is non-zero), the fourth power is (d * d) * (d * d).
+// Lanes hold partial sums, so the result may differ from the scalar sum of u by a few ULP.
+double penalty_sum(const double* x, size_t n, double a, double k) {
+    const SimdDouble zero = broadcastLanes(0.0), a_lanes = broadcastLanes(a);
+    SimdDouble sum = zero;
+    size_t i = 0;
+    for (; i + simd_lanes <= n; i += simd_lanes) {
+        SimdDouble v = loadLanes(x + i);
+        SimdDouble above = v - a_lanes, below = -v - a_lanes;
+        SimdDouble d = (above > zero ? above : zero) + (below > zero ? below : zero);
+        SimdDouble d2 = d * d;
+        sum += d2 * d2;
+    }
+    double result = sumLanes(sum);
+    for (; i < n; ++i) {
+        double d = std::max(x[i] - a, 0.0) + std::max(-x[i] - a, 0.0);
+        double d2 = d * d;
+        result += d2 * d2;
+    }
+    return k * result;
+}
 
-    double sum1 = std::accumulate(y.begin(), y.end() - 1, 0.0, [](double a, double b) { return a + std::pow(b - 1.0, 2.0) * (1.0 + 10.0 * std::sin(M_PI * b + 1.0) * std::sin(M_PI * b + 1.0)); });
-    double term1 = 10.0 * std::sin(M_PI * y[0]);
-    double term2 = std::pow(y.back() - 1.0, 2.0);
-    double sum2 = std::accumulate(position.begin(), position.end(), 0.0, [](double a, double b) { return a + u(b, 10.0, 100.0, 4.0); });
+// f12 and f13 on a raw array: y is computed on the fly, every sine is evaluated once
+double penalized1_kernel(const double* x, size_t n) {
+    double sum1 = 0.0;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        double b = 1.0 + (x[i] + 1.0) / 4.0;
+        double s = std::sin(M_PI * b + 1.0);
+        sum1 += ((b - 1.0) * (b - 1.0)) * (1.0 + 10.0 * s * s);
+    }
+    double y_first = 1.0 + (x[0] + 1.0) / 4.0;
+    double y_last = 1.0 + (x[n - 1] + 1.0) / 4.0;
+    double term1 = 10.0 * std::sin(M_PI * y_first);
+    double term2 = (y_last - 1.0) * (y_last - 1.0);
+    return M_PI / n * (term1 + sum1 + term2) + penalty_sum(x, n, 10.0, 100.0);
+}
 
-    return M_PI / position.size() * (term1 + sum1 + term2) + sum2;
+double penalized2_kernel(const double* x, size_t n) {
+    double sum1 = 0.0;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        double s = std::sin(3.0 * M_PI * x[i] + 1.0);
+        sum1 += ((x[i] - 1.0) * (x[i] - 1.0)) * (1.0 + s * s);
+    }
+    double s_first = std::sin(3.0 * M_PI * x[0]);
+    double s_last = std::sin(2.0 * M_PI * x[n - 1]);
+    double term1 = 0.1 * s_first * s_first;
+    double term2 = 0.1 * ((x[n - 1] - 1.0) * (x[n - 1] - 1.0)) * (1.0 + s_last * s_last);
+    return term1 + sum1 + term2 + penalty_sum(x, n, 5.0, 100.0);
 }
 
-double f13(const std::vector<double>& position) {
-    double sum1 = std::accumulate(position.begin(), position.end() - 1, 0.0, [](double a, double b) { return a + std::pow(b - 1.0, 2.0) * (1.0 + std::sin(3.0 * M_PI * b + 1.0) * std::sin(3.0 * M_PI * b + 1.0)); });
-    double term1 = 0.1 * std::sin(3.0 * M_PI * position[0]) * std::sin(3.0 * M_PI * position[0]);
-    double term2 = 0.1 * std::pow(position.back() - 1.0, 2.0) * (1.0 + std::sin(2.0 * M_PI * position.back()) * std::sin(2.0 * M_PI * position.back()));
-    double sum2 = std::accumulate(position.begin(), position.end(), 0.0, [](double a, double b) { return a + u(b, 5.0, 100.0, 4.0); });
+double f12(const std::vector<double>& position) {
+    return penalized1_kernel(position.data(), position.size());
+}
 
-    return term1 + sum1 + term2 + sum2;
+double f13(const std::vector<double>& position) {
+    return penalized2_kernel(position.data(), position.size());
 }
 
 // Composite Function F14 (CF1)
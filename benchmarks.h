@@ -2,6 +2,11 @@
 
 #include <vector>
 #include <cmath>
+#include <functional>
+
+// Objective as seen by the optimizers: a plain benchmark or a wrapper around it (cache, transforms)
+using Objective = std::function<double(const std::vector<double>&)>;
+
 #include "benchmarks.cpp"
 
 double f1(const std::vector<double>& position);
@@ -0,0 +1,241 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <map>
+#include <tuple>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "benchmarks.h"
+
+// Convergence curves: best-so-far fitness at log-spaced function-evaluation (FE) checkpoints.
+// A recorder samples into a buffer preallocated per run; at the end of the run the curve is
+// XOR-compressed against the previous sample (best-so-far stalls a lot, so most samples shrink
+// to one byte) and appended as one record to a binary file. Several threads and processes may
+// append to the same file. Queries (area under the curve, FEs to reach a target) decode the
+// records in one pass without building the curve.
+
+// Log-spaced FE checkpoints 1 .. max_evaluations, duplicates removed
+std::vector<uint64_t> log_schedule(uint64_t max_evaluations, size_t num_points) {
+    std::vector<uint64_t> checkpoints;
+    for (size_t p = 0; p < num_points; ++p) {
+        double fraction = num_points > 1 ? static_cast<double>(p) / (num_points - 1) : 1.0;
+        uint64_t fe = static_cast<uint64_t>(std::llround(std::pow(static_cast<double>(max_evaluations), fraction)));
+        if (checkpoints.empty() || fe > checkpoints.back()) checkpoints.push_back(fe);
+    }
+    return checkpoints;
+}
+
+class ConvergenceRecorder {
+public:
+    explicit ConvergenceRecorder(std::vector<uint64_t> checkpoints)
+        : checkpoints(std::move(checkpoints)), samples(this->checkpoints.size()) {}
+
+    // Called with the value of every evaluation
+    void record(double value) {
+        ++evaluations;
+        if (value < best) best = value;
+        while (next < checkpoints.size() && evaluations >= checkpoints[next]) samples[next++] = best;
+    }
+
+    // Starts a new run; the buffer is reused
+    void reset() {
+        evaluations = 0;
+        next = 0;
+        best = std::numeric_limits<double>::infinity();
+    }
+
+    // Checkpoints after the last evaluation keep the final best
+    const std::vector<double>& curve() {
+        for (size_t p = next; p < samples.size(); ++p) samples[p] = best;
+        return samples;
+    }
+
+    uint64_t evaluationCount() const { return evaluations; }
+
+private:
+    std::vector<uint64_t> checkpoints;
+    std::vector<double> samples;
+    size_t next = 0;
+    uint64_t evaluations = 0;
+    double best = std::numeric_limits<double>::infinity();
+};
+
+// Objective that reports every evaluation to the recorder
+Objective recorded_objective(Objective benchmark_function, ConvergenceRecorder& recorder) {
+    return [benchmark_function = std::move(benchmark_function), &recorder](const std::vector<double>& position) {
+        double value = benchmark_function(position);
+        recorder.record(value);
+        return value;
+    };
+}
+
+// Per sample: one byte with the number of zero bytes at the top (high nibble) and bottom
+// (low nibble) of bits ^ previous_bits, then the bytes in between. An unchanged sample is 0x88.
+void compressCurve(const std::vector<double>& curve, std::vector<uint8_t>& out) {
+    uint64_t previous = 0;
+    for (double value : curve) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        uint64_t delta = bits ^ previous;
+        previous = bits;
+        int leading = delta == 0 ? 8 : __builtin_clzll(delta) / 8;
+        int trailing = delta == 0 ? 0 : __builtin_ctzll(delta) / 8;
+        out.push_back(static_cast<uint8_t>(leading << 4 | (delta == 0 ? 8 : trailing)));
+        for (int b = 7 - leading; b >= trailing; --b) out.push_back(static_cast<uint8_t>(delta >> (8 * b)));
+    }
+}
+
+// Calls visit(index, value) for every sample of a compressed curve
+template <typename Visitor>
+void decodeCurve(const uint8_t* data, size_t num_points, Visitor visit) {
+    uint64_t bits = 0;
+    for (size_t p = 0; p < num_points; ++p) {
+        uint8_t header = *data++;
+        int leading = header >> 4;
+        int trailing = header & 0x0F;
+        if (leading < 8) {
+            uint64_t delta = 0;
+            for (int b = 7 - leading; b >= trailing; --b) delta |= static_cast<uint64_t>(*data++) << (8 * b);
+            bits ^= delta;
+        }
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        visit(p, value);
+    }
+}
+
+struct CurveHeader {
+    uint32_t algorithm;
+    uint32_t config;
+    uint32_t run;
+    uint32_t num_points;
+    uint64_t evaluations; // evaluations the run actually made
+    uint32_t num_bytes;   // compressed samples following the header
+    uint32_t reserved;
+};
+
+// Appends compressed curves to a file. One write() per record with O_APPEND, so concurrent
+// writers (threads or worker processes) never interleave records.
+class ConvergenceWriter {
+public:
+    explicit ConvergenceWriter(const std::string& path) {
+        fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    }
+
+    ~ConvergenceWriter() {
+        if (fd >= 0) close(fd);
+    }
+
+    ConvergenceWriter(const ConvergenceWriter&) = delete;
+    ConvergenceWriter& operator=(const ConvergenceWriter&) = delete;
+
+    bool append(uint32_t algorithm, uint32_t config, uint32_t run, ConvergenceRecorder& recorder) {
+        const std::vector<double>& curve = recorder.curve();
+        thread_local std::vector<uint8_t> record;
+        record.assign(sizeof(CurveHeader), 0);
+        compressCurve(curve, record);
+        CurveHeader header{algorithm, config, run, static_cast<uint32_t>(curve.size()), recorder.evaluationCount(),
+                           static_cast<uint32_t>(record.size() - sizeof(CurveHeader)), 0};
+        std::memcpy(record.data(), &header, sizeof(header));
+        return fd >= 0 && write(fd, record.data(), record.size()) == static_cast<ssize_t>(record.size());
+    }
+
+private:
+    int fd = -1;
+};
+
+// Whole file in memory with an index of the records
+class ConvergenceStore {
+public:
+    ConvergenceStore(const std::string& path, std::vector<uint64_t> checkpoints) : checkpoints(std::move(checkpoints)) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        char buffer[1 << 16];
+        ssize_t n;
+        while ((n = read(fd, buffer, sizeof(buffer))) > 0) data.insert(data.end(), buffer, buffer + n);
+        close(fd);
+
+        for (size_t offset = 0; offset + sizeof(CurveHeader) <= data.size();) {
+            CurveHeader header;
+            std::memcpy(&header, &data[offset], sizeof(header));
+            if (offset + sizeof(header) + header.num_bytes > data.size()) break; // truncated tail
+            records[{header.algorithm, header.config, header.run}] = offset;
+            offset += sizeof(header) + header.num_bytes;
+        }
+    }
+
+    size_t curveCount() const { return records.size(); }
+    size_t byteCount() const { return data.size(); }
+
+    bool contains(uint32_t algorithm, uint32_t config, uint32_t run) const {
+        return records.count({algorithm, config, run}) > 0;
+    }
+
+    std::vector<double> curve(uint32_t algorithm, uint32_t config, uint32_t run) const {
+        std::vector<double> values;
+        visit(algorithm, config, run, [&](size_t, double value) { values.push_back(value); });
+        return values;
+    }
+
+    // Trapezoidal area under log10(best - optimum) over log10(FE), divided by the log10(FE)
+    // range of the whole schedule: the mean log-error over the budget. Lower is better; it
+    // rewards converging early. Every run is integrated over the same checkpoints, a run that
+    // stopped early (at its target) holding its final best, so the scores of runs compare.
+    double areaUnderCurve(uint32_t algorithm, uint32_t config, uint32_t run, double optimum = 0.0) const {
+        if (checkpoints.empty() || !contains(algorithm, config, run)) return std::numeric_limits<double>::quiet_NaN();
+        double area = 0.0, previous_x = 0.0, previous_y = 0.0;
+        size_t points = 0;
+        auto add = [&](size_t p, double value) {
+            double x = std::log10(static_cast<double>(checkpoints[p]));
+            double y = std::log10(std::max(value - optimum, 1e-300));
+            if (p > 0) area += 0.5 * (x - previous_x) * (y + previous_y);
+            previous_x = x;
+            previous_y = y;
+            points = p + 1;
+        };
+        double last = std::numeric_limits<double>::infinity();
+        visit(algorithm, config, run, [&](size_t p, double value) {
+            add(p, value);
+            last = value;
+        });
+        // Records shorter than the schedule keep their last sample up to its end
+        for (size_t p = points; p < checkpoints.size(); ++p) add(p, last);
+        double range = std::log10(static_cast<double>(checkpoints.back())) - std::log10(static_cast<double>(checkpoints.front()));
+        return range > 0.0 ? area / range : previous_y;
+    }
+
+    // First checkpoint at which best-so-far reaches the target; 0 if never
+    uint64_t evaluationsToTarget(uint32_t algorithm, uint32_t config, uint32_t run, double target) const {
+        uint64_t reached = 0;
+        visit(algorithm, config, run, [&](size_t p, double value) {
+            if (reached == 0 && value <= target) reached = checkpoints[p];
+        });
+        return reached;
+    }
+
+    uint64_t evaluationCount(uint32_t algorithm, uint32_t config, uint32_t run) const {
+        auto it = records.find({algorithm, config, run});
+        if (it == records.end()) return 0;
+        CurveHeader header;
+        std::memcpy(&header, &data[it->second], sizeof(header));
+        return header.evaluations;
+    }
+
+private:
+    template <typename Visitor>
+    void visit(uint32_t algorithm, uint32_t config, uint32_t run, Visitor visitor) const {
+        auto it = records.find({algorithm, config, run});
+        if (it == records.end()) return;
+        CurveHeader header;
+        std::memcpy(&header, &data[it->second], sizeof(header));
+        decodeCurve(&data[it->second + sizeof(header)], std::min<size_t>(header.num_points, checkpoints.size()), visitor);
+    }
+
+    std::vector<uint64_t> checkpoints;
+    std::vector<uint8_t> data;
+    std::map<std::tuple<uint32_t, uint32_t, uint32_t>, size_t> records; // -> offset of the header
+};
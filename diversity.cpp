@@ -0,0 +1,248 @@
+#pragma once
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "benchmarks.h"
+#include "snapshot.cpp"
+#include "initialization.cpp"
+
+// Diversity and stagnation of the WOA and SCA populations, with restarts.
+// Both replace an agent only by a better point, so a population that has collapsed onto one point
+// spends the rest of its budget there. DiversityMonitor keeps the centroid and the spread (root
+// mean square distance of the agents to the centroid) up to date as agents are replaced, O(D) per
+// replacement and so at most O(N D) per iteration, and counts the iterations since the best value
+// last improved. With restarts on, a stagnated run starts again in the IPOP manner: the population
+// grows by population_growth (up to max_population_factor times its initial size; the rows it
+// grows into are allocated with the monitor, so a restart allocates nothing), is drawn anew by initialize_population except for the best agent, and
+// the iteration schedule starts over with the evaluations left of the original budget.
+// Everything is off by default; the optimizers then draw the same numbers as without the monitor.
+
+struct DiversitySettings {
+    bool monitor = false;            // keep the statistics of diversity_stats
+    bool restart = false;            // restart stagnated runs (monitors as well)
+    int stagnation_iterations = 100; // iterations without improvement of the best that count as stagnation
+    double improvement = 1e-10;      // relative decrease of the best that counts as an improvement
+    double collapse_spread = 1e-8;   // spread / diagonal of the search space below which the population has collapsed
+    double population_growth = 2.0;
+    int max_population_factor = 8;
+};
+
+inline thread_local DiversitySettings diversity_settings;
+
+// Statistics of the last monitored run of the thread
+struct DiversityStats {
+    int restarts = 0;
+    double spread = 0.0;          // at the end, relative to the diagonal of the search space
+    long long updates = 0;        // replacements seen by the monitor
+    double monitor_seconds = 0.0; // time spent in the monitor; replacements are sampled, which overestimates it a little
+};
+
+inline thread_local DiversityStats diversity_stats;
+
+class DiversityMonitor {
+public:
+    DiversityMonitor(int num_agents, const std::vector<std::pair<double, double>>& search_space)
+        : enabled(diversity_settings.monitor || diversity_settings.restart), initial_agents(num_agents),
+          shift(search_space.size()), sum(search_space.size()), sum_squares(search_space.size()) {
+        for (const auto& bounds : search_space) diagonal += (bounds.second - bounds.first) * (bounds.second - bounds.first);
+        diagonal = std::sqrt(diagonal);
+        if (enabled) diversity_stats = {};
+        if (restarting()) {
+            spare_rows.assign(capacity() - initial_agents, std::vector<double>(search_space.size()));
+            kept_best.resize(search_space.size());
+        }
+    }
+
+    ~DiversityMonitor() {
+        if (!enabled) return;
+        diversity_stats.restarts = restarts;
+        diversity_stats.spread = spread();
+        diversity_stats.updates = updates;
+        diversity_stats.monitor_seconds = seconds;
+    }
+
+    bool restarting() const { return diversity_settings.restart; }
+
+    // Most agents a run may have, for reserving the buffers
+    size_t capacity() const {
+        return restarting() ? static_cast<size_t>(initial_agents) * std::max(1, diversity_settings.max_population_factor) : initial_agents;
+    }
+
+    // Takes the population as it is, O(N D): after the initialization, a restart or a snapshot
+    // restore. The iterations without improvement are kept (a restored count stays).
+    void start(const std::vector<std::vector<double>>& agents, const std::vector<double>& fitness) {
+        if (!enabled) return;
+        Timed timed(*this);
+        best = *std::min_element(fitness.begin(), fitness.end());
+        improved_best = best;
+        rebase(agents);
+    }
+
+    // Agent moved from one position to a better one with this value. Two clock reads would cost
+    // about as much as the update itself, so only every 16th replacement is timed (and counted 16 times).
+    void replace(const std::vector<double>& from, const std::vector<double>& to, double value) {
+        if (!enabled) return;
+        if (updates++ % 16 == 0) {
+            Timed timed(*this, 16.0);
+            update(from, to, value);
+        } else {
+            update(from, to, value);
+        }
+    }
+
+    // End of an iteration; true if the run should restart
+    bool endIteration(const std::vector<std::vector<double>>& agents) {
+        if (!enabled) return false;
+        Timed timed(*this);
+        if (best < improved_best - diversity_settings.improvement * std::max(std::fabs(improved_best), 1e-300)) {
+            improved_best = best;
+            stagnant = 0;
+        } else {
+            ++stagnant;
+        }
+        // The sums are relative to the centroid of the last rebase and lose precision as the
+        // population contracts around another point; a fresh base keeps the spread exact
+        double variance = totalVariance();
+        if (variance < 1e-6 * base_variance) rebase(agents);
+
+        const int window = diversity_settings.stagnation_iterations;
+        return restarting() && (stagnant >= window || (stagnant >= window / 2 && spread() < diversity_settings.collapse_spread));
+    }
+
+    std::vector<double> centroid() const {
+        std::vector<double> center(shift.size());
+        for (size_t j = 0; j < shift.size(); ++j) center[j] = shift[j] + sum[j] / count;
+        return center;
+    }
+
+    // Relative to the diagonal of the search space
+    double spread() const {
+        return count && diagonal > 0.0 ? std::sqrt(totalVariance()) / diagonal : 0.0;
+    }
+
+    int stagnantIterations() const { return stagnant; }
+
+    // Fields of the run snapshot (written whether or not the monitor is on)
+    void snapshotFields(SnapshotArchive& archive) {
+        archive.field(stagnant);
+        archive.field(restarts);
+    }
+
+    void restarted() {
+        ++restarts;
+        stagnant = 0;
+    }
+
+    // Grows the population to num_agents rows from the spare rows; a population restored from a
+    // snapshot may already be larger than the pool assumes, then the pool is left over
+    void grow(std::vector<std::vector<double>>& agents, std::vector<double>& fitness, size_t num_agents) {
+        while (agents.size() < num_agents) {
+            if (spare_rows.empty()) {
+                agents.emplace_back(shift.size());
+            } else {
+                agents.push_back(std::move(spare_rows.back()));
+                spare_rows.pop_back();
+            }
+        }
+        fitness.resize(num_agents);
+    }
+
+    // Row that holds the best agent while the population is drawn anew
+    std::vector<double>& keptBest() { return kept_best; }
+
+private:
+    struct Timed {
+        explicit Timed(DiversityMonitor& monitor, double weight = 1.0)
+            : monitor(monitor), weight(weight), begin(std::chrono::steady_clock::now()) {}
+        ~Timed() { monitor.seconds += weight * std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count(); }
+        DiversityMonitor& monitor;
+        double weight;
+        std::chrono::steady_clock::time_point begin;
+    };
+
+    void update(const std::vector<double>& from, const std::vector<double>& to, double value) {
+        for (size_t j = 0; j < shift.size(); ++j) {
+            double a = from[j] - shift[j], b = to[j] - shift[j];
+            sum[j] += b - a;
+            sum_squares[j] += b * b - a * a;
+        }
+        best = std::min(best, value);
+    }
+
+    // Sum over the dimensions of the variance of the coordinates
+    double totalVariance() const {
+        double variance = 0.0;
+        for (size_t j = 0; j < shift.size(); ++j) {
+            double mean = sum[j] / count;
+            variance += std::max(0.0, sum_squares[j] / count - mean * mean);
+        }
+        return variance;
+    }
+
+    void rebase(const std::vector<std::vector<double>>& agents) {
+        count = agents.size();
+        std::fill(shift.begin(), shift.end(), 0.0);
+        for (const auto& agent : agents)
+            for (size_t j = 0; j < shift.size(); ++j) shift[j] += agent[j];
+        for (double& s : shift) s /= count;
+        std::fill(sum.begin(), sum.end(), 0.0);
+        std::fill(sum_squares.begin(), sum_squares.end(), 0.0);
+        for (const auto& agent : agents) {
+            for (size_t j = 0; j < shift.size(); ++j) {
+                double d = agent[j] - shift[j];
+                sum[j] += d;
+                sum_squares[j] += d * d;
+            }
+        }
+        base_variance = totalVariance();
+    }
+
+    bool enabled;
+    int initial_agents;
+    size_t count = 0;
+    std::vector<double> shift, sum, sum_squares; // sums of the coordinates minus shift
+    std::vector<std::vector<double>> spare_rows; // rows a restart grows the population into
+    std::vector<double> kept_best;
+    double diagonal = 0.0;
+    double base_variance = 0.0;
+    double best = std::numeric_limits<double>::infinity();
+    double improved_best = std::numeric_limits<double>::infinity();
+    int stagnant = 0;
+    int restarts = 0;
+    long long updates = 0;
+    double seconds = 0.0;
+};
+
+// IPOP restart of a stagnated run with evaluations_left of its budget. The population grows
+// within the capacity of the monitor and is drawn anew, the best agent stays in row 0 (so the
+// best value of the run never gets worse). Returns the iterations of the new epoch; 0 if the
+// budget does not cover one, then nothing changes.
+int restart_population(std::vector<std::vector<double>>& agents, std::vector<double>& fitness, long long evaluations_left,
+                       const std::vector<std::pair<double, double>>& search_space, const Objective& benchmark_function,
+                       DiversityMonitor& monitor) {
+    size_t num_agents = std::min(monitor.capacity(), static_cast<size_t>(std::lround(agents.size() * diversity_settings.population_growth)));
+    num_agents = std::max(num_agents, agents.size());
+    long long iterations = (evaluations_left - static_cast<long long>(num_agents) + 1) / static_cast<long long>(num_agents);
+    if (iterations < 1) return 0;
+
+    size_t best_index = std::distance(fitness.begin(), std::min_element(fitness.begin(), fitness.end()));
+    std::vector<double>& best_position = monitor.keptBest();
+    best_position = agents[best_index];
+    double best_fitness = fitness[best_index];
+    monitor.grow(agents, fitness, num_agents);
+
+    // Elites of earlier runs would pull the new population back to where it came from
+    const std::vector<std::vector<double>>* elites = population_init.elites;
+    population_init.elites = nullptr;
+    initialize_population(agents, search_space);
+    population_init.elites = elites;
+
+    agents[0].swap(best_position);
+    fitness[0] = best_fitness;
+    for (size_t i = 1; i < num_agents; ++i) fitness[i] = benchmark_function(agents[i]);
+    monitor.restarted();
+    monitor.start(agents, fitness);
+    return static_cast<int>(iterations);
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include "benchmarks.h"
+
+// Memoization cache in front of the benchmark function.
+// Exact mode keys on the bit pattern of the position, approximate mode on coordinates rounded
+// to a multiple of `quantum` (near-duplicates then share one evaluation).
+// The table is direct-mapped with a fixed number of slots, so memory stays bounded; each slot
+// is guarded by a sequence counter, readers never lock and a colliding insert just overwrites.
+// Only meant for deterministic objectives: a noisy benchmark (f7) would replay its first draw.
+
+enum class CacheMode { Exact, Approximate };
+
+class EvalCache {
+public:
+    EvalCache(size_t num_dimensions, size_t capacity, CacheMode mode = CacheMode::Exact, double quantum = 1e-9)
+        : num_dimensions(num_dimensions), mode(mode), quantum(quantum) {
+        size_t slots = 1;
+        while (slots < capacity) slots <<= 1;
+        mask = slots - 1;
+        table.reset(new Slot[slots]);
+        keys.reset(new std::atomic<uint64_t>[slots * num_dimensions]);
+        for (size_t i = 0; i < slots * num_dimensions; ++i) keys[i].store(0, std::memory_order_relaxed);
+    }
+
+    // Lock-free read; false if the position is not cached or its slot is being rewritten
+    bool lookup(const std::vector<double>& position, double& value) {
+        uint64_t hash = hashPosition(position);
+        Slot& slot = table[hash & mask];
+        uint64_t version = slot.version.load(std::memory_order_acquire);
+        bool found = (version & 1) == 0 && version != 0
+                     && slot.hash.load(std::memory_order_relaxed) == hash
+                     && keysMatch(hash & mask, position);
+        uint64_t value_bits = slot.value.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (!found || slot.version.load(std::memory_order_relaxed) != version) {
+            misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        std::memcpy(&value, &value_bits, sizeof(value));
+        hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Overwrites the slot of the position; skipped if another thread is writing it
+    void insert(const std::vector<double>& position, double value) {
+        uint64_t hash = hashPosition(position);
+        size_t index = hash & mask;
+        Slot& slot = table[index];
+        uint64_t version = slot.version.load(std::memory_order_relaxed);
+        if ((version & 1) != 0 || !slot.version.compare_exchange_strong(version, version + 1, std::memory_order_acquire))
+            return;
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t j = 0; j < num_dimensions; ++j)
+            keys[index * num_dimensions + j].store(keyOf(position[j]), std::memory_order_relaxed);
+        uint64_t value_bits;
+        std::memcpy(&value_bits, &value, sizeof(value));
+        slot.value.store(value_bits, std::memory_order_relaxed);
+        slot.hash.store(hash, std::memory_order_relaxed);
+        slot.version.store(version + 2, std::memory_order_release);
+    }
+
+    uint64_t hitCount() const { return hits.load(std::memory_order_relaxed); }
+    uint64_t missCount() const { return misses.load(std::memory_order_relaxed); }
+
+    double hitRate() const {
+        uint64_t total = hitCount() + missCount();
+        return total == 0 ? 0.0 : static_cast<double>(hitCount()) / total;
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> version{0}; // odd while a writer owns the slot, 0 while empty
+        std::atomic<uint64_t> hash{0};
+        std::atomic<uint64_t> value{0};
+    };
+
+    uint64_t keyOf(double x) const {
+        if (mode == CacheMode::Approximate)
+            return static_cast<uint64_t>(std::llround(x / quantum));
+        uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(x));
+        return bits;
+    }
+
+    uint64_t hashPosition(const std::vector<double>& position) const {
+        uint64_t hash = 0xCBF29CE484222325ULL;
+        for (double x : position) {
+            hash ^= keyOf(x);
+            hash *= 0x100000001B3ULL;
+            hash ^= hash >> 29;
+        }
+        return hash;
+    }
+
+    bool keysMatch(size_t index, const std::vector<double>& position) const {
+        if (position.size() != num_dimensions) return false;
+        for (size_t j = 0; j < num_dimensions; ++j) {
+            if (keys[index * num_dimensions + j].load(std::memory_order_relaxed) != keyOf(position[j]))
+                return false;
+        }
+        return true;
+    }
+
+    size_t num_dimensions;
+    CacheMode mode;
+    double quantum;
+    size_t mask;
+    std::unique_ptr<Slot[]> table;
+    std::unique_ptr<std::atomic<uint64_t>[]> keys;
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+};
+
+// Objective that consults the cache before calling the benchmark
+Objective cached_objective(Objective benchmark_function, EvalCache& cache) {
+    return [benchmark_function = std::move(benchmark_function), &cache](const std::vector<double>& position) {
+        double value;
+        if (cache.lookup(position, value)) return value;
+        value = benchmark_function(position);
+        cache.insert(position, value);
+        return value;
+    };
+}
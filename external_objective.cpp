@@ -0,0 +1,276 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <atomic>
+#include <stdexcept>
+#include <functional>
+#include <algorithm>
+#include <new>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <ctime>
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "benchmarks.h"
+
+// Objective evaluated by a separate local process (e.g. a simulator) through a shared-memory ring.
+// The ring has a fixed number of slots; each slot carries one batch of candidates and their values.
+// The optimizer side submits batches and collects them later, so several batches are in flight
+// while it keeps working. Slot states are changed with atomics and waited on with futexes.
+// stub_evaluator.cpp is a minimal evaluator process serving f1..f19; run_steady_state_external
+// (steady_state.cpp) drives the ask/tell optimizers through it.
+
+enum SlotState : uint32_t { SlotFree = 0, SlotFilling = 1, SlotSubmitted = 2, SlotEvaluating = 3, SlotDone = 4 };
+
+struct alignas(64) RingHeader {
+    uint32_t magic;
+    uint32_t num_slots;
+    uint32_t max_batch;
+    uint32_t dims;
+    std::atomic<uint32_t> submitted; // bumped on every submit, evaluators sleep on it
+    std::atomic<uint32_t> shutdown;
+};
+
+struct alignas(64) RingSlot {
+    std::atomic<uint32_t> state;
+    uint32_t count;       // candidates in the batch
+    uint32_t function_id; // which objective the evaluator should apply
+    uint64_t sequence;    // submission order, evaluators serve the oldest batch first
+    double seconds;       // time the evaluator spent on the batch
+};
+
+const uint32_t ring_magic = 0x52494E47; // "RING"
+
+size_t ringSize(uint32_t num_slots, uint32_t max_batch, uint32_t dims) {
+    return sizeof(RingHeader) + num_slots * sizeof(RingSlot)
+           + static_cast<size_t>(num_slots) * max_batch * (dims + 1) * sizeof(double);
+}
+
+inline RingSlot* ringSlots(RingHeader* header) {
+    return reinterpret_cast<RingSlot*>(header + 1);
+}
+
+// Candidates of slot s (count x dims, row-major) followed by their values
+inline double* slotPositions(RingHeader* header, uint32_t s) {
+    double* data = reinterpret_cast<double*>(ringSlots(header) + header->num_slots);
+    return data + static_cast<size_t>(s) * header->max_batch * (header->dims + 1);
+}
+
+inline double* slotValues(RingHeader* header, uint32_t s) {
+    return slotPositions(header, s) + static_cast<size_t>(header->max_batch) * header->dims;
+}
+
+// Sleeps while *word == expected (at most timeout_ms); shared futex, works across processes
+void futexWait(std::atomic<uint32_t>& word, uint32_t expected, long timeout_ms) {
+    timespec timeout{timeout_ms / 1000, (timeout_ms % 1000) * 1000000L};
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+
+void futexWake(std::atomic<uint32_t>& word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+// Evaluator side: serve batches until the client sets shutdown.
+// `evaluate` gets (function_id, candidates, count, dims, values).
+using BatchEvaluator = std::function<void(uint32_t, const double*, size_t, size_t, double*)>;
+
+int serve_ring(const std::string& shm_name, const BatchEvaluator& evaluate) {
+    int fd = shm_open(shm_name.c_str(), O_RDWR, 0600);
+    if (fd < 0) return 1;
+    struct stat info;
+    fstat(fd, &info);
+    void* memory = mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) return 1;
+    RingHeader* header = static_cast<RingHeader*>(memory);
+    if (header->magic != ring_magic) return 1;
+    RingSlot* slots = ringSlots(header);
+
+    while (!header->shutdown.load(std::memory_order_acquire)) {
+        uint32_t submitted = header->submitted.load(std::memory_order_acquire);
+
+        // Oldest submitted batch first; CAS lets several evaluator processes share one ring
+        int chosen = -1;
+        for (uint32_t s = 0; s < header->num_slots; ++s) {
+            if (slots[s].state.load(std::memory_order_acquire) == SlotSubmitted
+                && (chosen < 0 || slots[s].sequence < slots[chosen].sequence))
+                chosen = static_cast<int>(s);
+        }
+        uint32_t expected = SlotSubmitted;
+        if (chosen < 0) {
+            futexWait(header->submitted, submitted, 100);
+            continue;
+        }
+        if (!slots[chosen].state.compare_exchange_strong(expected, SlotEvaluating, std::memory_order_acq_rel))
+            continue;
+
+        auto start = std::chrono::steady_clock::now();
+        evaluate(slots[chosen].function_id, slotPositions(header, chosen), slots[chosen].count, header->dims,
+                 slotValues(header, chosen));
+        slots[chosen].seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        slots[chosen].state.store(SlotDone, std::memory_order_release);
+        futexWake(slots[chosen].state);
+    }
+    munmap(memory, info.st_size);
+    return 0;
+}
+
+// Client side: owns the ring and the evaluator process
+class ExternalEvaluator {
+public:
+    // `command` is started as `command <shm name>`
+    ExternalEvaluator(const std::string& command, uint32_t dims, uint32_t max_batch = 128, uint32_t num_slots = 4,
+                      uint32_t function_id = 0)
+        : function_id(function_id) {
+        static std::atomic<int> instance{0};
+        shm_name = "/metaheuristics_ring_" + std::to_string(getpid()) + "_" + std::to_string(instance++);
+        size = ringSize(num_slots, max_batch, dims);
+
+        int fd = shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0 || ftruncate(fd, size) != 0)
+            throw std::runtime_error("cannot create shared memory " + shm_name + ": " + std::strerror(errno));
+        void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (memory == MAP_FAILED)
+            throw std::runtime_error("cannot map shared memory " + shm_name);
+
+        header = new (memory) RingHeader{ring_magic, num_slots, max_batch, dims, {0}, {0}};
+        for (uint32_t s = 0; s < num_slots; ++s) new (&ringSlots(header)[s]) RingSlot{{SlotFree}, 0, 0, 0, 0.0};
+
+        evaluator_pid = fork();
+        if (evaluator_pid == 0) {
+            execl(command.c_str(), command.c_str(), shm_name.c_str(), static_cast<char*>(nullptr));
+            _exit(127);
+        }
+        if (evaluator_pid < 0)
+            throw std::runtime_error("cannot start evaluator " + command);
+    }
+
+    ~ExternalEvaluator() {
+        header->shutdown.store(1, std::memory_order_release);
+        header->submitted.fetch_add(1, std::memory_order_release);
+        futexWake(header->submitted);
+        if (evaluator_pid > 0) waitpid(evaluator_pid, nullptr, 0);
+        munmap(header, size);
+        shm_unlink(shm_name.c_str());
+    }
+
+    ExternalEvaluator(const ExternalEvaluator&) = delete;
+    ExternalEvaluator& operator=(const ExternalEvaluator&) = delete;
+
+    uint32_t maxBatch() const { return header->max_batch; }
+    uint32_t slotCount() const { return header->num_slots; }
+    uint32_t dimensions() const { return header->dims; }
+
+    // Hands a batch (count x dims, row-major, 1 <= count <= maxBatch, dims as given to the
+    // constructor) to the evaluator and returns its ticket; other batches throw
+    // std::invalid_argument. Blocks while every slot is being evaluated; at most slotCount()
+    // batches may be left uncollected.
+    uint32_t submit(const double* positions, size_t count, size_t dims) {
+        if (count == 0 || count > header->max_batch)
+            throw std::invalid_argument("external evaluator: batch of " + std::to_string(count) + " candidates, slots hold 1.." +
+                                        std::to_string(header->max_batch));
+        if (dims != header->dims)
+            throw std::invalid_argument("external evaluator: " + std::to_string(dims) + " dimensions, ring has " +
+                                        std::to_string(header->dims));
+        RingSlot* slots = ringSlots(header);
+        while (true) {
+            for (uint32_t s = 0; s < header->num_slots; ++s) {
+                uint32_t expected = SlotFree;
+                if (slots[s].state.compare_exchange_strong(expected, SlotFilling, std::memory_order_acquire)) {
+                    std::memcpy(slotPositions(header, s), positions, count * header->dims * sizeof(double));
+                    slots[s].count = static_cast<uint32_t>(count);
+                    slots[s].function_id = function_id;
+                    slots[s].sequence = next_sequence++;
+                    slots[s].state.store(SlotSubmitted, std::memory_order_release);
+                    header->submitted.fetch_add(1, std::memory_order_release);
+                    futexWake(header->submitted);
+                    return s;
+                }
+            }
+            // All slots in flight: the oldest one finishes first
+            int oldest = oldestInFlight();
+            if (oldest < 0)
+                throw std::logic_error("external evaluator: every slot holds an uncollected batch");
+            waitDone(oldest);
+        }
+    }
+
+    // Waits for a submitted batch, copies its values out and frees the slot; returns the
+    // seconds the evaluator spent on it
+    double collect(uint32_t ticket, double* values) {
+        waitDone(ticket);
+        RingSlot& slot = ringSlots(header)[ticket];
+        std::memcpy(values, slotValues(header, ticket), slot.count * sizeof(double));
+        double seconds = slot.seconds;
+        slot.state.store(SlotFree, std::memory_order_release);
+        return seconds;
+    }
+
+    // Whole population in maxBatch chunks with up to slotCount chunks in flight
+    void evaluate_batch(const double* positions, size_t count, double* values) {
+        std::vector<std::pair<uint32_t, size_t>> in_flight; // ticket, first candidate
+        size_t next = 0;
+        while (next < count || !in_flight.empty()) {
+            while (next < count && in_flight.size() < header->num_slots) {
+                size_t chunk = std::min<size_t>(header->max_batch, count - next);
+                in_flight.push_back({submit(positions + next * header->dims, chunk, header->dims), next});
+                next += chunk;
+            }
+            collect(in_flight.front().first, values + in_flight.front().second);
+            in_flight.erase(in_flight.begin());
+        }
+    }
+
+    // Synchronous single-point adapter for the generational optimizers: one batch of one
+    // candidate at a time, nothing overlaps. The ask/tell optimizers pipeline batches with
+    // run_steady_state_external (steady_state.cpp).
+    Objective objective() {
+        return [this](const std::vector<double>& position) {
+            double value;
+            collect(submit(position.data(), 1, position.size()), &value);
+            return value;
+        };
+    }
+
+private:
+    int oldestInFlight() {
+        RingSlot* slots = ringSlots(header);
+        int oldest = -1;
+        for (uint32_t s = 0; s < header->num_slots; ++s) {
+            uint32_t state = slots[s].state.load(std::memory_order_acquire);
+            if ((state == SlotSubmitted || state == SlotEvaluating) && (oldest < 0 || slots[s].sequence < slots[oldest].sequence))
+                oldest = static_cast<int>(s);
+        }
+        return oldest;
+    }
+
+    void waitDone(uint32_t s) {
+        RingSlot& slot = ringSlots(header)[s];
+        for (int spin = 0;; ++spin) {
+            uint32_t state = slot.state.load(std::memory_order_acquire);
+            if (state == SlotDone || state == SlotFree) return;
+            if (spin < 1000) continue;
+            futexWait(slot.state, state, 100);
+            if (waitpid(evaluator_pid, nullptr, WNOHANG) == evaluator_pid) {
+                evaluator_pid = -1;
+                throw std::runtime_error("external evaluator exited");
+            }
+        }
+    }
+
+    RingHeader* header;
+    size_t size;
+    std::string shm_name;
+    pid_t evaluator_pid = -1;
+    uint32_t function_id;
+    uint64_t next_sequence = 1;
+};
@@ -0,0 +1,277 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstdint>
+#include "random.cpp"
+
+// Initial populations of the optimizers.
+// Every optimizer fills its first population through initialize_population, one call for the
+// whole N x D block. The method is per thread, like the random engine: population_init selects
+// uniform random points (the default, the same numbers the optimizers drew before), a
+// scrambled Sobol or Halton sequence, or a Latin hypercube, and can put elites of earlier runs
+// (EliteArchive) in the first rows. The quasi-random points are randomized from the thread's
+// random stream (Sobol: digital shift, Halton: rotation modulo 1), so repeated runs still get
+// different populations and a run stays reproducible from its seed.
+
+enum class InitMethod { Uniform, Sobol, Halton, LatinHypercube };
+
+struct PopulationInit {
+    InitMethod method = InitMethod::Uniform;
+    const std::vector<std::vector<double>>* elites = nullptr; // warm start, best first
+    double elite_fraction = 0.2; // at most this share of the population comes from elites
+};
+
+inline thread_local PopulationInit population_init;
+
+void set_population_init(InitMethod method, const std::vector<std::vector<double>>* elites = nullptr,
+                         double elite_fraction = 0.2) {
+    population_init = {method, elites, elite_fraction};
+}
+
+InitMethod init_method_from_name(const std::string& name) {
+    if (name == "sobol") return InitMethod::Sobol;
+    if (name == "halton") return InitMethod::Halton;
+    if (name == "lhs") return InitMethod::LatinHypercube;
+    return InitMethod::Uniform;
+}
+
+// Sobol direction numbers: dimension 0 is van der Corput, dimension d the d-th primitive
+// polynomial over GF(2) by degree, with odd initial numbers m_k < 2^k from a fixed stream
+class SobolDirections {
+public:
+    static const SobolDirections& forDimensions(size_t num_dimensions) {
+        thread_local SobolDirections directions;
+        directions.extendTo(num_dimensions);
+        return directions;
+    }
+
+    const uint32_t* operator[](size_t dimension) const { return v[dimension].data(); }
+
+private:
+    void extendTo(size_t num_dimensions) {
+        if (v.empty()) {
+            std::vector<uint32_t> first(32);
+            for (int k = 0; k < 32; ++k) first[k] = 1u << (31 - k);
+            v.push_back(first);
+        }
+        while (v.size() < num_dimensions) {
+            do ++polynomial; while (!primitive(polynomial));
+            int degree = 31 - __builtin_clz(polynomial);
+            std::vector<uint32_t> m(33);
+            for (int k = 1; k <= degree; ++k) {
+                m_stream = splitmix64(m_stream);
+                m[k] = static_cast<uint32_t>(m_stream % (1u << (k - 1))) * 2 + 1;
+            }
+            for (int k = degree + 1; k <= 32; ++k) {
+                uint32_t value = m[k - degree] ^ (m[k - degree] << degree);
+                for (int i = 1; i < degree; ++i)
+                    if ((polynomial >> (degree - i)) & 1u) value ^= m[k - i] << i;
+                m[k] = value;
+            }
+            std::vector<uint32_t> directions(32);
+            for (int k = 1; k <= 32; ++k) directions[k - 1] = m[k] << (32 - k);
+            v.push_back(directions);
+        }
+    }
+
+    // x^e mod p over GF(2)
+    static uint32_t powerOfX(uint64_t e, uint32_t p, int degree) {
+        uint32_t result = 1, base = 2;
+        auto multiply = [p, degree](uint32_t a, uint32_t b) {
+            uint32_t product = 0;
+            for (; b; b >>= 1) {
+                if (b & 1u) product ^= a;
+                a <<= 1;
+                if (a >> degree) a ^= p;
+            }
+            return product;
+        };
+        for (; e; e >>= 1) {
+            if (e & 1u) result = multiply(result, base);
+            base = multiply(base, base);
+        }
+        return result;
+    }
+
+    // p (bit k: coefficient of x^k) is primitive: x has order 2^degree - 1 modulo p
+    static bool primitive(uint32_t p) {
+        if (!(p & 1u) || p < 3) return false;
+        int degree = 31 - __builtin_clz(p);
+        uint64_t order = (1ull << degree) - 1;
+        if (powerOfX(order, p, degree) != 1) return false;
+        uint64_t rest = order;
+        for (uint64_t q = 2; q * q <= rest; ++q) {
+            if (rest % q) continue;
+            while (rest % q == 0) rest /= q;
+            if (powerOfX(order / q, p, degree) == 1) return false;
+        }
+        if (rest > 1 && rest != order && powerOfX(order / rest, p, degree) == 1) return false;
+        return true;
+    }
+
+    std::vector<std::vector<uint32_t>> v;
+    uint32_t polynomial = 2; // the next primitive polynomial after this one
+    uint64_t m_stream = 0x5EED5EEDULL;
+};
+
+// The first num_primes primes
+std::vector<uint32_t> first_primes(size_t num_primes) {
+    std::vector<uint32_t> primes;
+    for (uint32_t n = 2; primes.size() < num_primes; ++n) {
+        bool prime = true;
+        for (uint32_t p : primes) {
+            if (p * p > n) break;
+            if (n % p == 0) {
+                prime = false;
+                break;
+            }
+        }
+        if (prime) primes.push_back(n);
+    }
+    return primes;
+}
+
+// Points in [0, 1)^D, row(i) = pointer to row i
+template <typename Row>
+void fillUnitPoints(InitMethod method, size_t num_agents, size_t dims, const Row& row) {
+    if (method == InitMethod::Sobol) {
+        const SobolDirections& v = SobolDirections::forDimensions(dims);
+        std::vector<uint32_t> shift(dims), x(dims, 0);
+        for (uint32_t& s : shift) s = static_cast<uint32_t>(random_engine() >> 32);
+        // Points 0 .. N - 1 in Gray code order; with the shift point 0 is not the corner, and a
+        // population of 2^k agents has one point in each interval of width 2^-k per dimension
+        for (size_t i = 0; i < num_agents; ++i) {
+            int c = __builtin_ctzll(static_cast<unsigned long long>(i + 1));
+            for (size_t j = 0; j < dims; ++j) {
+                row(i)[j] = static_cast<double>(x[j] ^ shift[j]) * 0x1.0p-32;
+                x[j] ^= v[j][c];
+            }
+        }
+    } else if (method == InitMethod::Halton) {
+        // Large bases give nearly parallel dimensions for small N; every dimension permutes its
+        // digits (all of them, down to the precision of a double)
+        std::vector<uint32_t> bases = first_primes(dims);
+        std::vector<std::vector<uint32_t>> digits(dims);
+        for (size_t j = 0; j < dims; ++j) {
+            digits[j].resize(bases[j]);
+            for (uint32_t d = 0; d < bases[j]; ++d) digits[j][d] = d;
+            for (uint32_t d = bases[j]; d > 1; --d) std::swap(digits[j][d - 1], digits[j][getRandomIndex(static_cast<int>(d))]);
+        }
+        for (size_t i = 0; i < num_agents; ++i) {
+            for (size_t j = 0; j < dims; ++j) {
+                double inverse = 0.0, scale = 1.0 / bases[j];
+                for (uint64_t n = i; scale > 0x1.0p-53; n /= bases[j], scale /= bases[j]) inverse += digits[j][n % bases[j]] * scale;
+                row(i)[j] = std::min(inverse, 1.0 - 0x1.0p-53);
+            }
+        }
+    } else if (method == InitMethod::LatinHypercube) {
+        // One point per stratum of width 1/N in every dimension
+        std::vector<size_t> strata(num_agents);
+        for (size_t j = 0; j < dims; ++j) {
+            for (size_t i = 0; i < num_agents; ++i) strata[i] = i;
+            for (size_t i = num_agents; i > 1; --i) std::swap(strata[i - 1], strata[getRandomIndex(static_cast<int>(i))]);
+            for (size_t i = 0; i < num_agents; ++i) row(i)[j] = (strata[i] + randomUnit()) / num_agents;
+        }
+    }
+}
+
+template <typename Row>
+void fillPopulation(size_t num_agents, const std::vector<std::pair<double, double>>& search_space, const Row& row) {
+    const size_t dims = search_space.size();
+    size_t first = 0;
+    if (population_init.elites) {
+        size_t max_elites = static_cast<size_t>(population_init.elite_fraction * num_agents);
+        for (const std::vector<double>& elite : *population_init.elites) {
+            if (first >= max_elites) break;
+            if (elite.size() != dims) continue;
+            for (size_t j = 0; j < dims; ++j)
+                row(first)[j] = std::clamp(elite[j], search_space[j].first, search_space[j].second);
+            ++first;
+        }
+    }
+
+    auto rest = [&](size_t i) { return row(first + i); };
+    if (population_init.method == InitMethod::Uniform) {
+        for (size_t i = 0; i < num_agents - first; ++i)
+            for (size_t j = 0; j < dims; ++j)
+                rest(i)[j] = search_space[j].first + (search_space[j].second - search_space[j].first) * randomUnit();
+        return;
+    }
+    fillUnitPoints(population_init.method, num_agents - first, dims, rest);
+    for (size_t i = 0; i < num_agents - first; ++i)
+        for (size_t j = 0; j < dims; ++j)
+            rest(i)[j] = search_space[j].first + (search_space[j].second - search_space[j].first) * rest(i)[j];
+}
+
+// Row-major N x D block
+void initialize_population(double* population, size_t num_agents, const std::vector<std::pair<double, double>>& search_space) {
+    const size_t dims = search_space.size();
+    fillPopulation(num_agents, search_space, [population, dims](size_t i) { return population + i * dims; });
+}
+
+void initialize_population(std::vector<std::vector<double>>& agents, const std::vector<std::pair<double, double>>& search_space) {
+    fillPopulation(agents.size(), search_space, [&agents](size_t i) { return agents[i].data(); });
+}
+
+// Best positions of earlier runs of one benchmark and dimension, kept in a text file:
+// one line per elite, the fitness followed by the coordinates
+class EliteArchive {
+public:
+    explicit EliteArchive(size_t capacity = 10) : capacity(capacity) {}
+
+    bool load(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) return false;
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream fields(line);
+            double fitness;
+            if (!(fields >> fitness)) continue;
+            std::vector<double> position;
+            for (double x; fields >> x;) position.push_back(x);
+            add(position, fitness);
+        }
+        return true;
+    }
+
+    bool save(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file.is_open()) return false;
+        file.precision(17);
+        for (const auto& entry : entries) {
+            file << entry.first;
+            for (double x : entry.second) file << ' ' << x;
+            file << '\n';
+        }
+        return static_cast<bool>(file);
+    }
+
+    // Keeps the capacity best, best first; positions already in the archive are not repeated
+    void add(const std::vector<double>& position, double fitness) {
+        for (const auto& entry : entries)
+            if (entry.second == position) return;
+        auto at = std::upper_bound(entries.begin(), entries.end(), fitness,
+                                   [](double value, const std::pair<double, std::vector<double>>& entry) { return value < entry.first; });
+        entries.insert(at, {fitness, position});
+        if (entries.size() > capacity) entries.pop_back();
+        positions_cache.clear();
+    }
+
+    const std::vector<std::vector<double>>& positions() {
+        if (positions_cache.size() != entries.size()) {
+            positions_cache.clear();
+            for (const auto& entry : entries) positions_cache.push_back(entry.second);
+        }
+        return positions_cache;
+    }
+
+    size_t size() const { return entries.size(); }
+
+private:
+    size_t capacity;
+    std::vector<std::pair<double, std::vector<double>>> entries;
+    std::vector<std::vector<double>> positions_cache;
+};
@@ -0,0 +1,227 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include "benchmarks.h"
+#include "random.cpp"
+#include "termination.cpp"
+#include "noise.cpp"
+#include "registry.cpp"
+#include "rotation.cpp"
+#include "ask_tell.cpp"
+#include "topology.cpp"
+
+// Many small runs interleaved on a few threads.
+// Every run is an ask/tell optimizer (ask_tell.cpp), i.e. a resumable step function: it hands out
+// its next generation and waits until it is told the values. A scheduler collects the pending
+// generations of many runs of the same benchmark into one row-major batch, evaluates it with the
+// benchmark's batch kernel and resumes the runs. Each run keeps its own random stream and target,
+// switched into the thread's state while it is stepped, so it gives the same result as when it
+// runs alone with the same seed. Noisy benchmarks draw from the thread's noise stream; with
+// per_run_noise every run also keeps its own (as LockstepRuns does) and is evaluated in a batch of
+// its own, so its noise does not depend on the other runs either.
+
+// Evaluates a row-major population: fitness[a] = f(population[a * dims .. (a + 1) * dims))
+using PopulationEvaluator = std::function<void(const double* population, size_t num_agents, size_t dims, double* fitness)>;
+
+PopulationEvaluator population_evaluator(const BenchmarkInfo& benchmark) {
+    return [&benchmark](const double* population, size_t num_agents, size_t dims, double* fitness) {
+        evaluate_population(benchmark, population, num_agents, dims, fitness);
+    };
+}
+
+// Shifted and rotated f<function_id> (rotation.cpp): the whole batch is rotated with one
+// matrix-matrix product, the composites with one per component.
+PopulationEvaluator shift_rotated_evaluator(int function_id, size_t dims, double bound) {
+    if (function_id >= 14) {
+        const CompositeSpec& spec = composite_specs[function_id - 14];
+        CompositeTransforms transforms = compositeTransforms(function_id, dims, bound);
+        return [&spec, transforms](const double* population, size_t num_agents, size_t dims, double* fitness) {
+            compositeShiftRotatedPopulation(spec, transforms, population, num_agents, dims, fitness);
+        };
+    }
+    const ShiftRotation& transform = shift_rotation_for(function_id, dims, bound);
+    const BenchmarkInfo& benchmark = *find_benchmark(function_id);
+    return [&transform, &benchmark](const double* population, size_t num_agents, size_t dims, double* fitness) {
+        thread_local std::vector<double> rotated;
+        rotated.resize(num_agents * dims);
+        rotate_population(transform, population, num_agents, rotated.data());
+        evaluate_population(benchmark, rotated.data(), num_agents, dims, fitness);
+    };
+}
+
+using OptimizerFactory = std::function<std::unique_ptr<AskTellOptimizer>()>;
+
+class BatchScheduler {
+public:
+    // Batches are flushed once they hold max_batch candidates (plus the rest of the last generation)
+    BatchScheduler(PopulationEvaluator evaluator, size_t num_dimensions, size_t max_batch = 2048, bool per_run_noise = false)
+        : evaluator(std::move(evaluator)), dims(num_dimensions), max_batch(max_batch), per_run_noise(per_run_noise) {}
+
+    // Adds a run; target as for set_run_target, noise_seed as for seed_noise (with per_run_noise).
+    // Returns the index of the run.
+    size_t add(std::unique_ptr<AskTellOptimizer> optimizer, uint64_t seed,
+               double target = -std::numeric_limits<double>::infinity(), uint64_t noise_seed = 0) {
+        Run run;
+        run.optimizer = std::move(optimizer);
+        run.random.seed(seed);
+        run.control.target = target;
+        run.noise.seed = noise_seed;
+        runs.push_back(std::move(run));
+        return runs.size() - 1;
+    }
+
+    // Steps all runs until every one has finished
+    void run() {
+        std::vector<size_t> active(runs.size());
+        for (size_t r = 0; r < runs.size(); ++r) active[r] = r;
+        RandomEngine saved_random = random_engine;
+        RunControl saved_control = run_control;
+        NoiseContext saved_noise = noise_context;
+
+        while (!active.empty()) {
+            std::vector<size_t> still_active;
+            size_t first = 0;
+            while (first < active.size()) {
+                // Gather generations until the batch is full, one run per batch with per-run noise
+                size_t last = first;
+                population.clear();
+                for (; last < active.size() && population.size() < max_batch * dims && (!per_run_noise || last == first); ++last)
+                    gather(runs[active[last]]);
+
+                fitness.resize(population.size() / dims);
+                if (!fitness.empty()) {
+                    if (per_run_noise) noise_context = runs[active[first]].noise;
+                    evaluator(population.data(), fitness.size(), dims, fitness.data());
+                    if (per_run_noise) runs[active[first]].noise = noise_context;
+                    ++batches;
+                    batched_candidates += fitness.size();
+                }
+
+                size_t offset = 0;
+                for (size_t k = first; k < last; ++k) {
+                    Run& run = runs[active[k]];
+                    offset = resume(run, offset);
+                    if (!run.optimizer->finished()) still_active.push_back(active[k]);
+                }
+                first = last;
+            }
+            active.swap(still_active);
+        }
+
+        random_engine = saved_random;
+        run_control = saved_control;
+        noise_context = saved_noise;
+    }
+
+    size_t runCount() const { return runs.size(); }
+    const AskTellOptimizer& optimizer(size_t run) const { return *runs[run].optimizer; }
+    const RunControl& control(size_t run) const { return runs[run].control; }
+    long long batchCount() const { return batches; }
+    double meanBatchSize() const { return batches ? static_cast<double>(batched_candidates) / batches : 0.0; }
+
+private:
+    struct Run {
+        std::unique_ptr<AskTellOptimizer> optimizer;
+        RandomEngine random;
+        RunControl control;
+        NoiseContext noise;
+        std::vector<Candidate> pending;
+        size_t num_pending = 0;
+    };
+
+    // Asks the run for its next generation and appends it to the batch
+    void gather(Run& run) {
+        random_engine = run.random;
+        run_control = run.control;
+        // Candidate buffers are kept between generations
+        for (run.num_pending = 0;; ++run.num_pending) {
+            if (run.num_pending == run.pending.size()) run.pending.emplace_back();
+            Candidate& candidate = run.pending[run.num_pending];
+            if (!run.optimizer->ask(candidate)) break;
+            population.insert(population.end(), candidate.position.begin(), candidate.position.end());
+        }
+        run.random = random_engine;
+    }
+
+    // Tells the run the values of its candidates, which start at fitness[offset]; returns the
+    // offset of the next run. Evaluations are counted as controlled_objective would.
+    size_t resume(Run& run, size_t offset) {
+        run_control = run.control;
+        for (size_t c = 0; c < run.num_pending; ++c) {
+            double value = fitness[offset++];
+            ++run_control.evaluations;
+            if (run_control.evaluations_to_target == 0 && target_reached(value))
+                run_control.evaluations_to_target = run_control.evaluations;
+            run.optimizer->tell(run.pending[c], value);
+        }
+        run.num_pending = 0;
+        run.control = run_control;
+        return offset;
+    }
+
+    PopulationEvaluator evaluator;
+    size_t dims;
+    size_t max_batch;
+    bool per_run_noise;
+    std::vector<Run> runs;
+    std::vector<double> population;
+    std::vector<double> fitness;
+    long long batches = 0;
+    long long batched_candidates = 0;
+};
+
+struct InterleavedResult {
+    std::vector<double> best_fitness;      // per run
+    std::vector<uint64_t> evaluations;
+    std::vector<uint64_t> evaluations_to_target;
+    long long batches;
+    double mean_batch_size;
+    double seconds;
+};
+
+// num_runs runs of the optimizer, run r seeded with seed_of_run(r) and, if given, its noise with
+// noise_seed_of_run(r), split into one scheduler per thread on a pinned pool
+InterleavedResult run_interleaved(const OptimizerFactory& make_optimizer, const PopulationEvaluator& evaluator,
+                                  size_t num_dimensions, int num_runs, const std::function<uint64_t(int)>& seed_of_run,
+                                  double target = -std::numeric_limits<double>::infinity(), int num_threads = 1,
+                                  size_t max_batch = 2048, const std::function<uint64_t(int)>& noise_seed_of_run = {}) {
+    InterleavedResult result{std::vector<double>(num_runs), std::vector<uint64_t>(num_runs),
+                             std::vector<uint64_t>(num_runs), 0, 0.0, 0.0};
+    num_threads = std::max(1, std::min(num_threads, num_runs));
+    std::mutex mutex;
+    long long batched_candidates = 0;
+
+    auto start_time = std::chrono::steady_clock::now();
+    {
+        TopologyExecutor executor(num_threads);
+        for (int t = 0; t < num_threads; ++t) {
+            executor.submit(0, [&, t]() {
+                BatchScheduler scheduler(evaluator, num_dimensions, max_batch, static_cast<bool>(noise_seed_of_run));
+                std::vector<int> owned;
+                for (int r = t; r < num_runs; r += num_threads) {
+                    scheduler.add(make_optimizer(), seed_of_run(r), target, noise_seed_of_run ? noise_seed_of_run(r) : 0);
+                    owned.push_back(r);
+                }
+                scheduler.run();
+
+                std::lock_guard<std::mutex> lock(mutex);
+                for (size_t k = 0; k < owned.size(); ++k) {
+                    result.best_fitness[owned[k]] = scheduler.optimizer(k).best().second;
+                    result.evaluations[owned[k]] = scheduler.control(k).evaluations;
+                    result.evaluations_to_target[owned[k]] = scheduler.control(k).evaluations_to_target;
+                }
+                result.batches += scheduler.batchCount();
+                batched_candidates += static_cast<long long>(scheduler.meanBatchSize() * scheduler.batchCount() + 0.5);
+            });
+        }
+        executor.wait();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    result.mean_batch_size = result.batches ? static_cast<double>(batched_candidates) / result.batches : 0.0;
+    return result;
+}
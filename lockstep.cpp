@@ -0,0 +1,179 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "benchmarks.h"
+#include "random.cpp"
+#include "noise.cpp"
+#include "termination.cpp"
+#include "initialization.cpp"
+#include "interleave.cpp"
+#include "population_update.cpp"
+
+// Lock-step multi-run: R independent runs of one optimizer advance together.
+// Positions, candidates and fitness of all runs live in contiguous R x N x D (R x N) tensors.
+// Every iteration each run proposes the candidates of all its agents from its own random stream,
+// the candidates of all runs are scored with one batch call, and each run applies the greedy
+// replacement. Updates are generational as in the ask/tell forms (ask_tell.cpp): a run gives
+// the same result as WoaAskTell / ScaAskTell / AoaAskTell driven one generation at a time with
+// the same seed. The updates use the population-wide kernels of population_update.cpp.
+
+enum class LockstepAlgorithm { WOA, SCA, AOA };
+
+struct LockstepResult {
+    std::vector<double> best_fitness;               // per run
+    std::vector<std::vector<double>> best_solution;
+    std::vector<uint64_t> evaluations;
+    std::vector<uint64_t> evaluations_to_target;
+    long long batch_calls;
+    double seconds;
+};
+
+class LockstepRuns {
+public:
+    // seeds and targets per run; noise_seeds (optional) make noisy benchmarks draw from a stream per run
+    LockstepRuns(LockstepAlgorithm algorithm, int num_agents, int max_iter,
+                 const std::vector<std::pair<double, double>>& search_space, const std::vector<uint64_t>& seeds,
+                 const std::vector<double>& targets, const std::vector<uint64_t>& noise_seeds = {})
+        : algorithm(algorithm), num_runs(seeds.size()), num_agents(num_agents), dims(search_space.size()),
+          max_iter(max_iter), search_space(search_space), bounds(search_space), positions(num_runs * num_agents * dims),
+          candidates(positions.size()), fitness(num_runs * num_agents, std::numeric_limits<double>::infinity()),
+          candidate_fitness(fitness.size()), random(num_runs), control(num_runs), noise(num_runs), running(num_runs, 1) {
+        for (size_t r = 0; r < num_runs; ++r) {
+            random[r].seed(seeds[r]);
+            control[r].target = targets[r];
+            if (r < noise_seeds.size()) noise[r].seed = noise_seeds[r];
+        }
+        per_run_noise = !noise_seeds.empty();
+    }
+
+    LockstepResult run(const PopulationEvaluator& evaluator) {
+        RandomEngine saved_random = random_engine;
+        RunControl saved_control = run_control;
+        NoiseContext saved_noise = noise_context;
+        auto start_time = std::chrono::steady_clock::now();
+
+        // Initial population, scored like any other generation
+        for (size_t r = 0; r < num_runs; ++r) {
+            random_engine = random[r];
+            initialize_population(candidate(r, 0), num_agents, search_space);
+            random[r] = random_engine;
+        }
+        evaluate(evaluator);
+        select();
+
+        for (int t = 0; t < max_iter; ++t) {
+            bool any_running = false;
+            for (size_t r = 0; r < num_runs; ++r) {
+                if (!running[r]) continue;
+                any_running = true;
+                random_engine = random[r];
+                propose(r, t);
+                random[r] = random_engine;
+            }
+            if (!any_running) break;
+            evaluate(evaluator);
+            select();
+        }
+
+        LockstepResult result;
+        for (size_t r = 0; r < num_runs; ++r) {
+            const double* run_fitness = &fitness[r * num_agents];
+            int best = static_cast<int>(std::min_element(run_fitness, run_fitness + num_agents) - run_fitness);
+            result.best_fitness.push_back(run_fitness[best]);
+            result.best_solution.emplace_back(agent(r, best), agent(r, best) + dims);
+            result.evaluations.push_back(control[r].evaluations);
+            result.evaluations_to_target.push_back(control[r].evaluations_to_target);
+        }
+        result.batch_calls = batch_calls;
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        random_engine = saved_random;
+        run_control = saved_control;
+        noise_context = saved_noise;
+        return result;
+    }
+
+private:
+    double* agent(size_t r, int i) { return &positions[(r * num_agents + i) * dims]; }
+    double* candidate(size_t r, int i) { return &candidates[(r * num_agents + i) * dims]; }
+
+    // One step of the optimizer for all agents of run r
+    void propose(size_t r, int t) {
+        if (algorithm == LockstepAlgorithm::WOA)
+            woa_update_population(agent(r, 0), num_agents, bounds, 2.0 - t * ((2.0) / max_iter), candidate(r, 0), coefficients);
+        else if (algorithm == LockstepAlgorithm::SCA)
+            sca_update_population(agent(r, 0), num_agents, dims, 2.0 - double(t) * (2.0 / double(max_iter)), candidate(r, 0), coefficients);
+        else
+            aoa_update_population(agent(r, 0), num_agents, bounds, static_cast<double>(t) / max_iter, candidate(r, 0));
+    }
+
+    // Scores the candidates of all running runs: one call per contiguous block of running runs,
+    // or one per run when every run has its own noise stream
+    void evaluate(const PopulationEvaluator& evaluator) {
+        for (size_t first = 0; first < num_runs;) {
+            if (!running[first]) {
+                ++first;
+                continue;
+            }
+            size_t last = first + 1;
+            while (!per_run_noise && last < num_runs && running[last]) ++last;
+            if (per_run_noise) noise_context = noise[first];
+            size_t rows = (last - first) * num_agents;
+            evaluator(&candidates[first * num_agents * dims], rows, dims, &candidate_fitness[first * num_agents]);
+            if (per_run_noise) noise[first] = noise_context;
+            ++batch_calls;
+            first = last;
+        }
+    }
+
+    // Greedy replacement and evaluation counting of every running run
+    void select() {
+        for (size_t r = 0; r < num_runs; ++r) {
+            if (!running[r]) continue;
+            run_control = control[r];
+            for (int i = 0; i < num_agents; ++i) {
+                double value = candidate_fitness[r * num_agents + i];
+                ++run_control.evaluations;
+                if (target_reached(value)) {
+                    if (run_control.evaluations_to_target == 0) run_control.evaluations_to_target = run_control.evaluations;
+                    running[r] = 0;
+                }
+                if (value < fitness[r * num_agents + i]) {
+                    std::copy(candidate(r, i), candidate(r, i) + dims, agent(r, i));
+                    fitness[r * num_agents + i] = value;
+                }
+            }
+            control[r] = run_control;
+        }
+    }
+
+    LockstepAlgorithm algorithm;
+    size_t num_runs;
+    int num_agents;
+    size_t dims;
+    int max_iter;
+    std::vector<std::pair<double, double>> search_space;
+    PopulationBounds bounds;
+    UpdateCoefficients coefficients;
+    std::vector<double> positions;  // R x N x D
+    std::vector<double> candidates; // R x N x D
+    std::vector<double> fitness;    // R x N
+    std::vector<double> candidate_fitness;
+    std::vector<RandomEngine> random;
+    std::vector<RunControl> control;
+    std::vector<NoiseContext> noise;
+    std::vector<char> running; // 0 once the run reached its target
+    bool per_run_noise = false;
+    long long batch_calls = 0;
+};
+
+LockstepResult lockstep_runs(LockstepAlgorithm algorithm, int num_agents, int max_iter,
+                             const std::vector<std::pair<double, double>>& search_space,
+                             const PopulationEvaluator& evaluator, const std::vector<uint64_t>& seeds,
+                             const std::vector<double>& targets, const std::vector<uint64_t>& noise_seeds = {}) {
+    LockstepRuns runs(algorithm, num_agents, max_iter, search_space, seeds, targets, noise_seeds);
+    return runs.run(evaluator);
+}
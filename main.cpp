@@ -5,6 +5,13 @@
 #include <cmath>
 #include <fstream>
 #include <iomanip>
+#include <string>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <set>
 
 // Including files
 #include "SSA.cpp"
@@ -14,109 +21,628 @@
 #include "AOA.cpp"
 #include "WOA.cpp"
 #include "benchmarks.h"
+#include "eval_cache.cpp"
+#include "rotation.cpp"
+#include "sweep.cpp"
+#include "topology.cpp"
+#include "surrogate.cpp"
+#include "convergence.cpp"
+#include "registry.cpp"
+#include "termination.cpp"
+#include "memory.cpp"
+#include "interleave.cpp"
+#include "lockstep.cpp"
+#include "ssa_scan.cpp"
+#include "split_eval.cpp"
+#include "portfolio.cpp"
+#include "initialization.cpp"
+#include "metrics.cpp"
+#include "diversity.cpp"
+#include "steady_state.cpp"
 
 using namespace std;
 
 // Structure for storing the configuration of benchmarks
 struct BenchmarkConfig {
-    double (*benchmark_func)(const std::vector<double>&); // Evaluation function (benchmark)
+    const BenchmarkInfo* benchmark; // Registry entry: function, optimum, capabilities
     std::vector<std::pair<double, double>> search_space; // Search space (boundaries)
 };
 
-// Template function for executing and evaluating algorithms
-template <typename AlgorithmFunc>
-vector<vector<double>> run_and_evaluate(const string& algorithm_name, AlgorithmFunc algorithm, int num_runs, const std::vector<BenchmarkConfig>& configs) {
-    std::vector<vector<double>> all_results(configs.size(), vector<double>(3, 0.0));
-    
-    // Functions for calculating the mean and standard deviation
-    double (*mean_function)(const std::vector<double>&) = [](const std::vector<double>& values) {
-        return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+// Evaluation cache in front of the benchmark (see eval_cache.cpp), off by default
+const bool use_eval_cache = false;
+const size_t eval_cache_capacity = 1 << 14;
+
+// Run the shifted and rotated variants of the benchmarks (see rotation.cpp) instead of the plain ones
+const bool use_shift_rotation = false;
+
+// Stop a run once it gets within target_tolerance of the benchmark's known optimum (see termination.cpp)
+const bool stop_at_target = true;
+const double target_tolerance = 1e-8;
+
+// Record convergence curves of every run to convergence.bin (see convergence.cpp), off by default
+const bool record_convergence = false;
+const char* const convergence_path = "convergence.bin";
+
+// FE checkpoints of the curves; the budget covers the largest run (TLBO: two evaluations per student and iteration)
+const std::vector<uint64_t>& convergence_checkpoints() {
+    static const std::vector<uint64_t> checkpoints = log_schedule(1 << 20, 100);
+    return checkpoints;
+}
+
+// One writer per process; threads and worker processes append whole records
+ConvergenceWriter& convergence_writer() {
+    static ConvergenceWriter writer(convergence_path);
+    return writer;
+}
+
+// Benchmarks of the sweep: names, labels or tags of registry.cpp, set with --benchmarks
+std::string benchmark_selection = "all";
+
+// Benchmark configurations of the sweep, default bounds and dimensions of the registry
+std::vector<BenchmarkConfig> benchmark_configs() {
+    std::vector<BenchmarkConfig> configs;
+    for (const BenchmarkInfo* benchmark : select_benchmarks(benchmark_selection))
+        configs.push_back({benchmark, benchmark->searchSpace()});
+    return configs;
+}
+
+// In the serial mode, run the repetitions of WOA, SCA and AOA in lock step with one batch evaluation per
+// iteration for all of them (see lockstep.cpp); updates become generational. --lockstep on|off, off by default
+bool use_lockstep_runs = false;
+
+// In the serial mode, run SSA with the follower chain as a scan over this many chunks and batch
+// evaluation (see ssa_scan.cpp); chunks beyond the first run on a pinned pool. --ssa-scan CHUNKS, 0: ssa()
+size_t ssa_scan_chunks = 0;
+
+// Memory budget of the jobs running at once in --threads mode (see memory.cpp), set with
+// --memory-budget MB; by default 80% of the memory available at start, 0: no limit
+double memory_budget_fraction = 0.8;
+size_t memory_budget_bytes = 0;
+
+// Population size and iterations of every optimizer in the sweep
+const int sweep_agents = 100;
+const int sweep_iterations = 3000;
+
+// Snapshots of the serial runs (see snapshot.cpp), one file per run in this directory, set with
+// --snapshots DIR; a run whose file exists resumes from it. Empty: no snapshots.
+std::string snapshot_dir;
+const int snapshot_interval = 100; // iterations
+
+// Initial populations (see initialization.cpp): --init uniform|sobol|halton|lhs. With --elites DIR
+// every run puts up to elite_fraction of its population at the best positions of earlier runs of
+// the same benchmark and dimension (DIR/f<id>_D<dims>.elites) by earlier sweeps (see SweepElites).
+InitMethod init_method = InitMethod::Uniform;
+std::string elite_dir;
+const size_t elite_capacity = 10;
+const double elite_fraction = 0.2;
+
+std::string elite_path(const BenchmarkConfig& config) {
+    return elite_dir + "/" + config.benchmark->label() + "_D" + std::to_string(config.search_space.size()) + ".elites";
+}
+
+// Elite archives of one sweep. A configuration's file is read once, on first use, and its
+// positions stay fixed for the rest of the sweep: every run warm-starts from the same elites,
+// whichever algorithms and runs came before it, so the runs stay independent. The best positions
+// of the runs are collected aside and merged into the files by save() after the sweep. Sharded
+// workers read the archives but return no positions, so only this process's runs are merged.
+class SweepElites {
+public:
+    // Elites to seed the runs of configs[config_idx] with; nullptr without --elites
+    const std::vector<std::vector<double>>* positions(size_t config_idx, const BenchmarkConfig& config) {
+        if (elite_dir.empty()) return nullptr;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto archive = archives.find(config_idx);
+        if (archive == archives.end()) {
+            archive = archives.emplace(config_idx, Archive{EliteArchive(elite_capacity), {}, {}}).first;
+            archive->second.loaded.load(elite_path(config));
+            archive->second.positions = archive->second.loaded.positions();
+        }
+        return &archive->second.positions;
+    }
+
+    void add(size_t config_idx, const std::vector<double>& position, double fitness) {
+        if (elite_dir.empty()) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        archives[config_idx].found.push_back({fitness, position});
+    }
+
+    // Merges the results of the sweep into the files; false if one cannot be written
+    bool save(const std::vector<BenchmarkConfig>& configs) {
+        std::lock_guard<std::mutex> lock(mutex);
+        bool ok = true;
+        for (auto& [config_idx, archive] : archives) {
+            if (archive.found.empty()) continue;
+            for (const auto& [fitness, position] : archive.found) archive.loaded.add(position, fitness);
+            archive.found.clear();
+            if (!archive.loaded.save(elite_path(configs[config_idx]))) {
+                std::cerr << "Cannot write " << elite_path(configs[config_idx]) << std::endl;
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
+private:
+    struct Archive {
+        EliteArchive loaded{elite_capacity};
+        std::vector<std::vector<double>> positions;
+        std::vector<std::pair<double, std::vector<double>>> found;
     };
-    double (*stddev_function)(const std::vector<double>&, double) = [](const std::vector<double>& values, double mean_val) {
-        double variance = std::accumulate(values.begin(), values.end(), 0.0, [mean_val](double acc, double val) {
-            return acc + (val - mean_val) * (val - mean_val);
-        }) / values.size();
-        return std::sqrt(variance);
+
+    std::mutex mutex;
+    std::map<size_t, Archive> archives;
+};
+
+SweepElites sweep_elites;
+
+// Diversity monitor of WOA and SCA (see diversity.cpp): --diversity monitor reports the final spread
+// of the population and the monitor's share of the run time, --diversity ipop also restarts runs
+// that stagnate for --stagnation ITERATIONS with a larger population
+DiversitySettings run_diversity;
+
+bool diversity_report() {
+    return run_diversity.monitor || run_diversity.restart;
+}
+
+// Optimizer with its fixed parameters, as called by the sweep (with sweep_iterations); snapshots may be nullptr
+using Algorithm = std::function<std::pair<std::vector<double>, double>(const Objective&, const std::vector<std::pair<double, double>>&,
+                                                                       int, RunSnapshots*)>;
+
+struct AlgorithmEntry {
+    std::string name;
+    Algorithm run;
+};
+
+std::vector<AlgorithmEntry> algorithm_table() {
+    return {
+        {"WOA", [](const Objective& benchmark_function, const auto& search_space, int max_iter, RunSnapshots* snapshots) {
+            return woa(sweep_agents, max_iter, search_space, benchmark_function, snapshots);
+        }},
+        {"AOA", [](const Objective& benchmark_function, const auto& search_space, int max_iter, RunSnapshots* snapshots) {
+            return aoa(sweep_agents, max_iter, search_space, benchmark_function, snapshots);
+        }},
+        {"SSA", [](const Objective& benchmark_function, const auto& search_space, int max_iter, RunSnapshots* snapshots) {
+            return ssa(sweep_agents, max_iter, search_space, benchmark_function, snapshots);
+        }},
+        {"ICA", [](const Objective& benchmark_function, const auto& search_space, int max_iter, RunSnapshots* snapshots) {
+            return ica(sweep_agents, max_iter, search_space, 10, benchmark_function, snapshots);
+        }},
+        {"TLBO", [](const Objective& benchmark_function, const auto& search_space, int max_iter, RunSnapshots* snapshots) {
+            return tlbo(sweep_agents, max_iter, search_space, benchmark_function, snapshots);
+        }},
+        {"SCA", [](const Objective& benchmark_function, const auto& search_space, int max_iter, RunSnapshots* snapshots) {
+            return sca(sweep_agents, max_iter, search_space, benchmark_function, snapshots);
+        }},
     };
-    
+}
+
+// Functions for calculating the mean and standard deviation
+double mean_value(const std::vector<double>& values) {
+    return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+double stddev_value(const std::vector<double>& values, double mean_val) {
+    double variance = std::accumulate(values.begin(), values.end(), 0.0, [mean_val](double acc, double val) {
+        return acc + (val - mean_val) * (val - mean_val);
+    }) / values.size();
+    return std::sqrt(variance);
+}
+
+// Cache of a configuration's values, nullptr when the cache is off. Noisy benchmarks must not go
+// through it. The table is 16384 x D keys, so it is only allocated when it is used.
+std::unique_ptr<EvalCache> make_eval_cache(const BenchmarkConfig& config) {
+    if (!use_eval_cache || config.benchmark->has(CapNoisy)) return nullptr;
+    return std::make_unique<EvalCache>(config.search_space.size(), eval_cache_capacity);
+}
+
+double hit_rate(const EvalCache* cache) {
+    return cache ? cache->hitRate() : 0.0;
+}
+
+// Benchmark of a configuration with the optional transform and cache (may be nullptr) in front of it
+Objective configure_objective(const BenchmarkConfig& config, EvalCache* cache) {
+    Objective benchmark_function = config.benchmark->function;
+    if (use_shift_rotation)
+        benchmark_function = shift_rotated(config.benchmark->id, config.search_space.size(), config.search_space[0].second);
+    else if (config.search_space.size() >= split_eval_threshold)
+        benchmark_function = split_objective(config.benchmark->id, benchmark_function);
+    if (cache)
+        benchmark_function = cached_objective(benchmark_function, *cache);
+    return benchmark_function;
+}
+
+// Optimum of a benchmark as it is run, NaN if unknown. The registry's optimum does not hold for the
+// shifted and rotated variants: M (x - o) leaves the box, and f8 is lower outside of it.
+double known_optimum(const BenchmarkInfo& benchmark, size_t num_dimensions) {
+    if (use_shift_rotation) return std::numeric_limits<double>::quiet_NaN();
+    return benchmark.optimumFor(num_dimensions);
+}
+
+// Target of a run; -inf (run the whole budget) if the optimum is unknown or the benchmark is noisy
+double run_target(const BenchmarkConfig& config) {
+    double optimum = known_optimum(*config.benchmark, config.search_space.size());
+    if (!stop_at_target || std::isnan(optimum) || config.benchmark->has(CapNoisy))
+        return -std::numeric_limits<double>::infinity();
+    return optimum + target_tolerance;
+}
+
+// Seed of the optimizer's random stream for one run; the same in every execution mode and
+// for every benchmark selection
+uint64_t run_seed(const BenchmarkConfig& config, int run) {
+    return splitmix64(static_cast<uint64_t>(config.benchmark->id - 1) * 1000003ULL + static_cast<uint64_t>(run) + 1);
+}
+
+// Template function for executing and evaluating algorithms
+template <typename AlgorithmFunc>
+vector<vector<double>> run_and_evaluate(const string& algorithm_name, AlgorithmFunc algorithm, int num_runs, const std::vector<BenchmarkConfig>& configs,
+                                        uint32_t algorithm_idx = 0) {
+    // mean fitness, stddev, mean time, cache hit rate, target success rate, expected running time,
+    // peak and steady-state memory of a run (bytes, mean over the runs), restarts, monitor's share
+    // of the run time, final spread of the population
+    std::vector<vector<double>> all_results(configs.size(), vector<double>(11, 0.0));
+
     // Main loop for running algorithms and collecting results
     for (size_t config_idx = 0; config_idx < configs.size(); ++config_idx) {
-        auto& benchmark_function = configs[config_idx].benchmark_func;
         auto& search_space = configs[config_idx].search_space;
 
+        // One cache per benchmark, shared by all runs: values of a deterministic function stay valid
+        std::unique_ptr<EvalCache> cache = make_eval_cache(configs[config_idx]);
+        Objective benchmark_function = memory_objective(metered_objective(controlled_objective(configure_objective(configs[config_idx], cache.get()))));
+        ConvergenceRecorder recorder(convergence_checkpoints());
+        if (record_convergence)
+            benchmark_function = recorded_objective(benchmark_function, recorder);
+
         std::vector<double> fitness_results;
         std::vector<double> run_times;
+        std::vector<double> peak_bytes, steady_bytes;
+        std::vector<double> restarts, monitor_shares, spreads;
+        ErtStatistics ert;
+        const std::vector<std::vector<double>>* elites = sweep_elites.positions(config_idx, configs[config_idx]);
 
         for (int i = 0; i < num_runs; ++i) {
+            RunProgress progress(algorithm_name.c_str(), configs[config_idx].benchmark->id);
+            std::string snapshot_path = snapshot_dir + "/" + algorithm_name + "_" + configs[config_idx].benchmark->label() +
+                                        "_run" + std::to_string(i) + ".snap";
+            MemoryScope memory_scope;
             auto start_time = std::chrono::high_resolution_clock::now();
-            auto [best_solution, fitness] = algorithm(benchmark_function, search_space);
+            std::pair<std::vector<double>, double> outcome;
+            while (true) {
+                set_population_init(init_method, elites, elite_fraction);
+                seed_noise(static_cast<uint64_t>(i) + 1); // reproducible noise for noisy benchmarks (f7)
+                seed_random(run_seed(configs[config_idx], i));
+                recorder.reset();
+                set_run_target(run_target(configs[config_idx]));
+                diversity_settings = run_diversity;
+                diversity_stats = {};
+                memory_scope = MemoryScope();
+                start_time = std::chrono::high_resolution_clock::now();
+                std::unique_ptr<RunSnapshots> snapshots;
+                if (!snapshot_dir.empty()) snapshots = std::make_unique<RunSnapshots>(snapshot_path, snapshot_interval);
+                try {
+                    outcome = algorithm(benchmark_function, search_space, sweep_iterations, snapshots.get());
+                } catch (const SnapshotError& error) {
+                    // A stale or corrupt file must not end the sweep: keep it aside and run from scratch
+                    snapshots.reset();
+                    std::rename(snapshot_path.c_str(), (snapshot_path + ".bad").c_str());
+                    std::cerr << "Warning: " << error.what() << "; moved to " << snapshot_path << ".bad, the run starts over" << std::endl;
+                    continue;
+                }
+                if (snapshots) snapshots->discard(); // complete, a restart runs it again from the start
+                break;
+            }
+            auto& [best_solution, fitness] = outcome;
             auto end_time = std::chrono::high_resolution_clock::now();
             std::chrono::duration<double> run_time = end_time - start_time;
+            RunMemory memory = memory_scope.finish();
+            if (record_convergence)
+                convergence_writer().append(algorithm_idx, config_idx, i, recorder);
 
             fitness_results.push_back(fitness);
             run_times.push_back(run_time.count());
+            ert.add(run_control.evaluations, run_control.evaluations_to_target);
+            peak_bytes.push_back(memory.peak_bytes);
+            steady_bytes.push_back(memory.steady_bytes);
+            restarts.push_back(diversity_stats.restarts);
+            monitor_shares.push_back(diversity_stats.monitor_seconds / run_time.count());
+            spreads.push_back(diversity_stats.spread);
+            sweep_elites.add(config_idx, best_solution, fitness);
         }
+        set_population_init(InitMethod::Uniform);
         // Calculation of average, standard deviation and average execution time
-        all_results[config_idx][0] = mean_function(fitness_results);
-        all_results[config_idx][1] = stddev_function(fitness_results, all_results[config_idx][0]);
-        all_results[config_idx][2] = mean_function(run_times);
+        all_results[config_idx][0] = mean_value(fitness_results);
+        all_results[config_idx][1] = stddev_value(fitness_results, all_results[config_idx][0]);
+        all_results[config_idx][2] = mean_value(run_times);
+        all_results[config_idx][3] = hit_rate(cache.get());
+        all_results[config_idx][4] = ert.successRate();
+        all_results[config_idx][5] = ert.expectedRunningTime();
+        all_results[config_idx][6] = mean_value(peak_bytes);
+        all_results[config_idx][7] = mean_value(steady_bytes);
+        all_results[config_idx][8] = mean_value(restarts);
+        all_results[config_idx][9] = mean_value(monitor_shares);
+        all_results[config_idx][10] = mean_value(spreads);
     }
     return all_results;
 }
 
-int main() {
-    const int num_runs = 30;
+// Lock-step form of an optimizer of the table, false if it has none
+bool lockstep_form(const std::string& algorithm_name, LockstepAlgorithm& algorithm) {
+    if (algorithm_name == "WOA") algorithm = LockstepAlgorithm::WOA;
+    else if (algorithm_name == "SCA") algorithm = LockstepAlgorithm::SCA;
+    else if (algorithm_name == "AOA") algorithm = LockstepAlgorithm::AOA;
+    else return false;
+    return true;
+}
 
-    std::vector<BenchmarkConfig> configs = {
-            {f1, std::vector<std::pair<double, double>>(20, {-100.0, 100.0})},
-            {f2, std::vector<std::pair<double, double>>(20, {-10.0, 10.0})},
-            {f3, std::vector<std::pair<double, double>>(20, {-100.0, 100.0})},
-            {f4, std::vector<std::pair<double, double>>(20, {-100.0, 100.0})},
-            {f5, std::vector<std::pair<double, double>>(20, {-30,30})},
-            {f6, std::vector<std::pair<double, double>>(20, {-10.0, 10.0})},
-            {f7, std::vector<std::pair<double, double>>(20, {-1.28,1.28})},
-            {f8, std::vector<std::pair<double, double>>(20, {-500,500})},
-            {f9, std::vector<std::pair<double, double>>(20, {-5.12,5.12})},
-            {f10, std::vector<std::pair<double, double>>(20, {-32,32})},
-            {f11, std::vector<std::pair<double, double>>(20, {-600,600})},
-            {f12, std::vector<std::pair<double, double>>(20, {-50,50})},
-            {f13, std::vector<std::pair<double, double>>(20, {-50,50})},
-            {f14, std::vector<std::pair<double, double>>(10, {-5,5})},
-            {f15, std::vector<std::pair<double, double>>(10, {-5,5})},
-            {f16, std::vector<std::pair<double, double>>(10, {-5,5})},
-            {f17, std::vector<std::pair<double, double>>(10, {-5,5})},
-            {f18, std::vector<std::pair<double, double>>(10, {-5,5})},
-            {f19, std::vector<std::pair<double, double>>(10, {-5,5})},
-    };
+// Same table as run_and_evaluate, all runs of a benchmark advancing together. The evaluation
+// cache does not apply; time and memory are those of all runs divided by the number of runs
+// (the tensors are allocated once, so steady-state memory equals the peak).
+vector<vector<double>> run_lockstep_and_evaluate(LockstepAlgorithm algorithm, int num_runs, const std::vector<BenchmarkConfig>& configs) {
+    std::vector<vector<double>> all_results(configs.size(), vector<double>(11, 0.0));
+    for (size_t config_idx = 0; config_idx < configs.size(); ++config_idx) {
+        const BenchmarkConfig& config = configs[config_idx];
+        const BenchmarkInfo& benchmark = *config.benchmark;
+        size_t dims = config.search_space.size();
+        PopulationEvaluator evaluator = use_shift_rotation ? shift_rotated_evaluator(benchmark.id, dims, config.search_space[0].second)
+                                                           : population_evaluator(benchmark);
+        std::vector<uint64_t> seeds, noise_seeds;
+        std::vector<double> targets;
+        for (int i = 0; i < num_runs; ++i) {
+            seeds.push_back(run_seed(config, i));
+            noise_seeds.push_back(static_cast<uint64_t>(i) + 1);
+            targets.push_back(run_target(config));
+        }
 
-    std::vector<std::string> algorithm_names = {"WOA", "AOA", "SSA", "ICA", "TLBO", "SCA"};
-    std::vector<std::vector<vector<double>>> all_algorithm_results;
+        set_population_init(init_method, sweep_elites.positions(config_idx, config), elite_fraction);
+        MemoryScope memory_scope;
+        LockstepResult result = lockstep_runs(algorithm, sweep_agents, sweep_iterations, config.search_space, evaluator, seeds,
+                                              targets, benchmark.has(CapNoisy) ? noise_seeds : std::vector<uint64_t>{});
+        RunMemory memory = memory_scope.finish();
+        set_population_init(InitMethod::Uniform);
+
+        ErtStatistics ert;
+        for (int i = 0; i < num_runs; ++i) {
+            ert.add(result.evaluations[i], result.evaluations_to_target[i]);
+            sweep_elites.add(config_idx, result.best_solution[i], result.best_fitness[i]);
+        }
+        all_results[config_idx][0] = mean_value(result.best_fitness);
+        all_results[config_idx][1] = stddev_value(result.best_fitness, all_results[config_idx][0]);
+        all_results[config_idx][2] = result.seconds / num_runs;
+        all_results[config_idx][4] = ert.successRate();
+        all_results[config_idx][5] = ert.expectedRunningTime();
+        all_results[config_idx][6] = static_cast<double>(memory.peak_bytes) / num_runs;
+        all_results[config_idx][7] = static_cast<double>(memory.peak_bytes) / num_runs;
+    }
+    return all_results;
+}
+
+// Same table as run_and_evaluate for SSA through ssa_scan: every run scores its salps with one call of
+// the benchmark's batch kernel, the follower chain is split into num_chunks chunks. The evaluation
+// cache does not apply, and memory is the peak of each run (no per-evaluation sampling).
+vector<vector<double>> run_ssa_scan_and_evaluate(size_t num_chunks, int num_runs, const std::vector<BenchmarkConfig>& configs) {
+    std::vector<vector<double>> all_results(configs.size(), vector<double>(11, 0.0));
+    std::unique_ptr<TopologyExecutor> executor;
+    if (num_chunks > 1) executor = std::make_unique<TopologyExecutor>(static_cast<int>(num_chunks));
+    for (size_t config_idx = 0; config_idx < configs.size(); ++config_idx) {
+        const BenchmarkConfig& config = configs[config_idx];
+        const BenchmarkInfo& benchmark = *config.benchmark;
+        size_t dims = config.search_space.size();
+        PopulationEvaluator evaluator = use_shift_rotation ? shift_rotated_evaluator(benchmark.id, dims, config.search_space[0].second)
+                                                           : population_evaluator(benchmark);
+        const std::vector<std::vector<double>>* elites = sweep_elites.positions(config_idx, config);
+
+        std::vector<double> fitness_results, run_times, peak_bytes;
+        ErtStatistics ert;
+        for (int i = 0; i < num_runs; ++i) {
+            set_population_init(init_method, elites, elite_fraction);
+            seed_noise(static_cast<uint64_t>(i) + 1);
+            seed_random(run_seed(config, i));
+            set_run_target(run_target(config));
+            RunProgress progress("SSA", benchmark.id);
+            MemoryScope memory_scope;
+            auto start_time = std::chrono::high_resolution_clock::now();
+            auto [best_solution, fitness] = ssa_scan(sweep_agents, sweep_iterations, config.search_space, evaluator, num_chunks, executor.get());
+            std::chrono::duration<double> run_time = std::chrono::high_resolution_clock::now() - start_time;
+            sweep_elites.add(config_idx, best_solution, fitness);
+            fitness_results.push_back(fitness);
+            run_times.push_back(run_time.count());
+            peak_bytes.push_back(memory_scope.finish().peak_bytes);
+            ert.add(run_control.evaluations, run_control.evaluations_to_target);
+        }
+        set_population_init(InitMethod::Uniform);
+
+        all_results[config_idx][0] = mean_value(fitness_results);
+        all_results[config_idx][1] = stddev_value(fitness_results, all_results[config_idx][0]);
+        all_results[config_idx][2] = mean_value(run_times);
+        all_results[config_idx][4] = ert.successRate();
+        all_results[config_idx][5] = ert.expectedRunningTime();
+        all_results[config_idx][6] = mean_value(peak_bytes);
+        all_results[config_idx][7] = mean_value(peak_bytes);
+    }
+    return all_results;
+}
+
+// One (algorithm, config, run) job of the sharded sweep, executed inside a worker process
+SweepResult run_sweep_job(const SweepJob& job) {
+    static const std::vector<BenchmarkConfig> configs = benchmark_configs();
+    static const std::vector<AlgorithmEntry> algorithms = algorithm_table();
+    const BenchmarkConfig& config = configs[job.config];
+
+    std::unique_ptr<EvalCache> cache = make_eval_cache(config);
+    Objective benchmark_function = memory_objective(metered_objective(controlled_objective(configure_objective(config, cache.get()))));
+    thread_local ConvergenceRecorder recorder(convergence_checkpoints());
+    recorder.reset();
+    if (record_convergence)
+        benchmark_function = recorded_objective(benchmark_function, recorder);
 
-    all_algorithm_results.push_back(run_and_evaluate("WOA", [](auto benchmark_function, auto search_space) {
-        return woa(100, 3000, search_space, benchmark_function);
-    }, num_runs, configs));
+    set_population_init(init_method, sweep_elites.positions(job.config, config), elite_fraction);
 
-    all_algorithm_results.push_back(run_and_evaluate("AOA", [](auto benchmark_function, auto search_space) {
-        return aoa(100, 3000, search_space, benchmark_function);
-    }, num_runs, configs));
+    seed_noise(static_cast<uint64_t>(job.run) + 1);
+    seed_random(run_seed(config, job.run));
+    set_run_target(run_target(config));
+    diversity_settings = run_diversity;
+    diversity_stats = {};
+    RunProgress progress(algorithms[job.algorithm].name.c_str(), config.benchmark->id);
+    MemoryScope memory_scope;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    auto [best_solution, fitness] = algorithms[job.algorithm].run(benchmark_function, config.search_space, sweep_iterations, nullptr);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> run_time = end_time - start_time;
+    RunMemory memory = memory_scope.finish();
+    set_population_init(InitMethod::Uniform);
+    sweep_elites.add(job.config, best_solution, fitness); // merged by the --threads sweep, not by workers
+    if (record_convergence)
+        convergence_writer().append(job.algorithm, job.config, job.run, recorder);
 
-    all_algorithm_results.push_back(run_and_evaluate("SSA", [](auto benchmark_function, auto search_space) {
-        return ssa(100, 3000, search_space, benchmark_function);
-    }, num_runs, configs));
+    return {job.algorithm, job.config, job.run, static_cast<uint32_t>(diversity_stats.restarts), fitness, run_time.count(),
+            hit_rate(cache.get()), run_control.evaluations, run_control.evaluations_to_target, memory.peak_bytes, memory.steady_bytes,
+            diversity_stats.monitor_seconds, diversity_stats.spread};
+}
+
+std::vector<SweepJob> sweep_jobs(int num_runs, size_t num_algorithms, size_t num_configs) {
+    std::vector<SweepJob> jobs;
+    for (uint32_t a = 0; a < num_algorithms; ++a)
+        for (uint32_t c = 0; c < num_configs; ++c)
+            for (uint32_t r = 0; r < static_cast<uint32_t>(num_runs); ++r)
+                jobs.push_back({a, c, r, 0});
+    return jobs;
+}
+
+// Per-job records -> the table of run_and_evaluate (mean, stddev, time, cache hit rate, success rate, ERT, memory,
+// diversity)
+vector<vector<vector<double>>> aggregate_results(std::vector<SweepResult> results, size_t num_jobs,
+                                                 size_t num_algorithms, size_t num_configs) {
+    // Completion order varies between executions; summing in run order keeps the table reproducible
+    std::sort(results.begin(), results.end(), [](const SweepResult& a, const SweepResult& b) {
+        return std::tie(a.algorithm, a.config, a.run) < std::tie(b.algorithm, b.config, b.run);
+    });
+    std::vector<std::vector<std::vector<double>>> fitness(num_algorithms, std::vector<std::vector<double>>(num_configs));
+    std::vector<std::vector<std::vector<double>>> times = fitness, hit_rates = fitness, peak_bytes = fitness, steady_bytes = fitness;
+    std::vector<std::vector<std::vector<double>>> restarts = fitness, monitor_shares = fitness, spreads = fitness;
+    std::vector<std::vector<ErtStatistics>> ert(num_algorithms, std::vector<ErtStatistics>(num_configs));
+    for (const SweepResult& result : results) {
+        fitness[result.algorithm][result.config].push_back(result.fitness);
+        times[result.algorithm][result.config].push_back(result.seconds);
+        hit_rates[result.algorithm][result.config].push_back(result.cache_hit_rate);
+        ert[result.algorithm][result.config].add(result.evaluations, result.evaluations_to_target);
+        peak_bytes[result.algorithm][result.config].push_back(result.peak_bytes);
+        steady_bytes[result.algorithm][result.config].push_back(result.steady_bytes);
+        restarts[result.algorithm][result.config].push_back(result.restarts);
+        monitor_shares[result.algorithm][result.config].push_back(result.monitor_seconds / result.seconds);
+        spreads[result.algorithm][result.config].push_back(result.spread);
+    }
+
+    vector<vector<vector<double>>> all_algorithm_results(num_algorithms, vector<vector<double>>(num_configs, vector<double>(11, 0.0)));
+    for (size_t a = 0; a < num_algorithms; ++a) {
+        for (size_t c = 0; c < num_configs; ++c) {
+            if (fitness[a][c].empty()) continue;
+            all_algorithm_results[a][c][0] = mean_value(fitness[a][c]);
+            all_algorithm_results[a][c][1] = stddev_value(fitness[a][c], all_algorithm_results[a][c][0]);
+            all_algorithm_results[a][c][2] = mean_value(times[a][c]);
+            all_algorithm_results[a][c][3] = mean_value(hit_rates[a][c]);
+            all_algorithm_results[a][c][4] = ert[a][c].successRate();
+            all_algorithm_results[a][c][5] = ert[a][c].expectedRunningTime();
+            all_algorithm_results[a][c][6] = mean_value(peak_bytes[a][c]);
+            all_algorithm_results[a][c][7] = mean_value(steady_bytes[a][c]);
+            all_algorithm_results[a][c][8] = mean_value(restarts[a][c]);
+            all_algorithm_results[a][c][9] = mean_value(monitor_shares[a][c]);
+            all_algorithm_results[a][c][10] = mean_value(spreads[a][c]);
+        }
+    }
+    if (results.size() != num_jobs)
+        std::cerr << "Sweep incomplete: " << results.size() << " of " << num_jobs << " jobs" << std::endl;
+    return all_algorithm_results;
+}
+
+// Command line of a local worker: this program with the options that shape the jobs
+// (benchmarks, initialization, diversity, ...), without those of the coordinator
+std::vector<std::string> worker_command(int argc, char** argv) {
+    static const std::set<std::string> coordinator_options = {"--workers", "--socket", "--worker", "--threads",
+                                                              "--metrics-socket", "--metrics-port", "--dashboard"};
+    std::vector<std::string> command = {"/proc/self/exe"};
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (coordinator_options.count(argv[i])) continue;
+        command.push_back(argv[i]);
+        command.push_back(argv[i + 1]);
+    }
+    return command;
+}
 
-    all_algorithm_results.push_back(run_and_evaluate("ICA", [](auto benchmark_function, auto search_space) {
-        return ica(100, 3000, search_space, 10, benchmark_function);
-    }, num_runs, configs));
+// Same table as run_and_evaluate, but the runs are sharded over worker processes (see sweep.cpp)
+vector<vector<vector<double>>> run_sharded(const std::string& socket_path, int num_workers, int num_runs,
+                                           size_t num_algorithms, size_t num_configs,
+                                           const std::vector<std::string>& command) {
+    std::vector<SweepJob> jobs = sweep_jobs(num_runs, num_algorithms, num_configs);
+    std::vector<SweepResult> results = run_coordinator(socket_path, num_workers, jobs, command);
+    return aggregate_results(results, jobs.size(), num_algorithms, num_configs);
+}
 
-    all_algorithm_results.push_back(run_and_evaluate("TLBO", [](auto benchmark_function, auto search_space) {
-        return tlbo(100, 3000, search_space, benchmark_function);
-    }, num_runs, configs));
+// Peak footprint of a job of run_sweep_job, measured on a short run of the configuration before the
+// threaded sweep: what the job sets up around the optimizer (evaluation cache, objective wrappers,
+// convergence recorder) plus the peak of the run itself (RunMemory::peak_bytes). The optimizers
+// size their buffers by agents and dimensions, so a few iterations reach the peak of the whole run;
+// IPOP restarts may grow the population up to max_population_factor times, which the estimate
+// allows for. The executor admits jobs by it.
+size_t measured_footprint(const AlgorithmEntry& algorithm, const BenchmarkConfig& config) {
+    const int probe_iterations = 3;
+    int64_t before_setup = memory_account.live;
+    std::unique_ptr<EvalCache> cache = make_eval_cache(config);
+    Objective benchmark_function = memory_objective(metered_objective(controlled_objective(configure_objective(config, cache.get()))));
+    std::unique_ptr<ConvergenceRecorder> recorder;
+    if (record_convergence) {
+        recorder = std::make_unique<ConvergenceRecorder>(convergence_checkpoints());
+        benchmark_function = recorded_objective(benchmark_function, *recorder);
+    }
+    size_t setup_bytes = static_cast<size_t>(std::max<int64_t>(0, memory_account.live - before_setup));
 
-    all_algorithm_results.push_back(run_and_evaluate("SCA", [](auto benchmark_function, auto search_space) {
-        return sca(100, 3000, search_space, benchmark_function);
-    }, num_runs, configs));
+    seed_random(run_seed(config, 0));
+    set_run_target(-std::numeric_limits<double>::infinity());
+    diversity_settings = run_diversity;
+    MemoryScope memory_scope;
+    algorithm.run(benchmark_function, config.search_space, probe_iterations, nullptr);
+    RunMemory memory = memory_scope.finish();
+    diversity_settings = {};
+    size_t growth = run_diversity.restart ? std::max(1, run_diversity.max_population_factor) : 1;
+    return setup_bytes + static_cast<size_t>(memory.peak_bytes) * growth;
+}
 
+// Same table again, with the runs on threads pinned to the CPU topology (see topology.cpp).
+// Runs of one benchmark are grouped on one L3 domain.
+// Runs start only while their measured footprints fit into memory_budget_bytes.
+vector<vector<vector<double>>> run_threaded(int num_threads, int num_runs, const std::vector<AlgorithmEntry>& algorithms,
+                                            const std::vector<BenchmarkConfig>& configs,
+                                            std::map<int, double>& node_throughput) {
+    std::vector<SweepJob> jobs = sweep_jobs(num_runs, algorithms.size(), configs.size());
+    std::vector<SweepResult> results;
+    std::mutex results_mutex;
+    {
+        TopologyExecutor executor(num_threads);
+        executor.setMemoryBudget(memory_budget_bytes);
+        // One probe per algorithm and configuration (the cache and transforms depend on the benchmark)
+        std::map<std::pair<uint32_t, uint32_t>, size_t> footprints;
+        for (const SweepJob& job : jobs) {
+            auto footprint = footprints.find({job.algorithm, job.config});
+            if (memory_budget_bytes > 0 && footprint == footprints.end())
+                footprint = footprints.emplace(std::make_pair(job.algorithm, job.config),
+                                               measured_footprint(algorithms[job.algorithm], configs[job.config])).first;
+            size_t estimate = footprint == footprints.end() ? 0 : footprint->second;
+            executor.submit(job.config, [&results, &results_mutex, job]() {
+                SweepResult result = run_sweep_job(job);
+                std::lock_guard<std::mutex> lock(results_mutex);
+                results.push_back(result);
+            }, estimate);
+        }
+        executor.wait();
+        node_throughput = executor.nodeThroughput();
+        if (memory_budget_bytes > 0)
+            std::cerr << "Memory budget " << memory_budget_bytes / 1048576.0 << " MiB, peak estimate of concurrent runs "
+                      << executor.peakReservedMemory() / 1048576.0 << " MiB" << std::endl;
+    }
+    return aggregate_results(results, jobs.size(), algorithms.size(), configs.size());
+}
 
+int write_results(const std::vector<AlgorithmEntry>& algorithms, const std::vector<std::vector<vector<double>>>& all_algorithm_results,
+                  const std::vector<BenchmarkConfig>& configs,
+                  const std::map<int, double>& node_throughput) {
     std::ofstream outfile("results.txt");
 
     if (!outfile.is_open()) {
@@ -125,17 +651,419 @@ int main() {
     }
 
     outfile << std::fixed << std::setprecision(2);
-    for (const auto& name : algorithm_names)
-        outfile << std::setw(15) << name;
+    for (const auto& algorithm : algorithms)
+        outfile << std::setw(15) << algorithm.name;
     outfile << '\n';
 
     for (size_t config_idx = 0; config_idx < configs.size(); ++config_idx) {
-        outfile << "f" << config_idx + 1 << ": ";
+        outfile << configs[config_idx].benchmark->label() << ": ";
         for (const auto& alg_results : all_algorithm_results)
             outfile << std::setw(5) << alg_results[config_idx][0] << " " << std::setw(5) << alg_results[config_idx][1] << " " << std::setw(5) << alg_results[config_idx][2] << " |";
         outfile << '\n';
     }
+
+    if (use_eval_cache) {
+        outfile << "\nEvaluation cache hit rate, %\n";
+        for (size_t config_idx = 0; config_idx < configs.size(); ++config_idx) {
+            outfile << configs[config_idx].benchmark->label() << ": ";
+            for (const auto& alg_results : all_algorithm_results)
+                outfile << std::setw(15) << alg_results[config_idx][3] * 100.0;
+            outfile << '\n';
+        }
+    }
+
+    if (stop_at_target) {
+        // '-': no target (unknown optimum or noisy); ERT inf: never reached
+        outfile << "\nTarget (optimum + " << std::scientific << std::setprecision(0) << target_tolerance << std::fixed
+                << std::setprecision(2) << "): success rate, % / expected running time, evaluations\n";
+        for (size_t config_idx = 0; config_idx < configs.size(); ++config_idx) {
+            outfile << configs[config_idx].benchmark->label() << ": ";
+            bool has_target = std::isfinite(run_target(configs[config_idx]));
+            for (const auto& alg_results : all_algorithm_results) {
+                if (has_target)
+                    outfile << std::setw(7) << alg_results[config_idx][4] * 100.0 << " " << std::setw(10) << alg_results[config_idx][5] << " |";
+                else
+                    outfile << std::setw(18) << "-" << " |";
+            }
+            outfile << '\n';
+        }
+    }
+
+    if (record_convergence) {
+        // Mean log-error over the whole budget and mean FEs to get within target_tolerance of the optimum (0: not reached);
+        // '-' where the registry knows no optimum
+        ConvergenceStore store(convergence_path, convergence_checkpoints());
+        outfile << "\nConvergence: area under log10 error curve / FEs to target (" << store.curveCount() << " curves, "
+                << store.byteCount() << " bytes)\n";
+        for (size_t config_idx = 0; config_idx < configs.size(); ++config_idx) {
+            outfile << configs[config_idx].benchmark->label() << ": ";
+            double optimum = known_optimum(*configs[config_idx].benchmark, configs[config_idx].search_space.size());
+            for (uint32_t a = 0; a < algorithms.size(); ++a) {
+                if (std::isnan(optimum)) {
+                    outfile << std::setw(15) << "-" << " |";
+                    continue;
+                }
+                double area = 0.0, evaluations = 0.0;
+                int count = 0;
+                for (uint32_t run = 0; store.contains(a, config_idx, run); ++run, ++count) {
+                    area += store.areaUnderCurve(a, config_idx, run, optimum);
+                    evaluations += store.evaluationsToTarget(a, config_idx, run, optimum + target_tolerance);
+                }
+                outfile << std::setw(7) << (count ? area / count : 0.0) << " " << std::setw(7)
+                        << (count ? evaluations / count : 0.0) << " |";
+            }
+            outfile << '\n';
+        }
+    }
+
+    // Peak: most bytes the run's thread held at once; steady state: mean held at the evaluations
+    outfile << "\nMemory per run, KiB: peak / steady state\n";
+    for (size_t config_idx = 0; config_idx < configs.size(); ++config_idx) {
+        outfile << configs[config_idx].benchmark->label() << ": ";
+        for (const auto& alg_results : all_algorithm_results)
+            outfile << std::setw(9) << alg_results[config_idx][6] / 1024.0 << " " << std::setw(9) << alg_results[config_idx][7] / 1024.0 << " |";
+        outfile << '\n';
+    }
+
+    if (diversity_report()) {
+        // Only WOA and SCA have the monitor; the others show zeros
+        outfile << "\nDiversity: restarts per run / monitor time, % of the run / final spread of the population, % of the diagonal\n";
+        for (size_t config_idx = 0; config_idx < configs.size(); ++config_idx) {
+            outfile << configs[config_idx].benchmark->label() << ": ";
+            for (const auto& alg_results : all_algorithm_results)
+                outfile << std::setw(6) << alg_results[config_idx][8] << " " << std::setw(5) << alg_results[config_idx][9] * 100.0
+                        << " " << std::scientific << std::setprecision(1) << alg_results[config_idx][10] * 100.0 << std::fixed
+                        << std::setprecision(2) << " |";
+            outfile << '\n';
+        }
+    }
+
+    if (!node_throughput.empty()) {
+        outfile << "\nThroughput per NUMA node, runs/s\n";
+        for (const auto& entry : node_throughput)
+            outfile << "node " << entry.first << ": " << entry.second << '\n';
+    }
     outfile.close();
+    return 0;
+}
+
+// Surrogate pre-screening (see surrogate.cpp) against the unscreened run with the same seed,
+// for the optimizers that have an ask/tell form with greedy replacement
+int write_surrogate_report(const std::vector<BenchmarkConfig>& configs, int num_runs) {
+    const int num_agents = 30, max_iter = 200;
+    const SurrogateConfig surrogate_config;
+    std::vector<std::pair<std::string, std::function<SurrogateResult(const Objective&, const std::vector<std::pair<double, double>>&, const SurrogateConfig&)>>> algorithms = {
+        {"WOA", [&](const Objective& f, const auto& search_space, const SurrogateConfig& c) { return woa_surrogate(num_agents, max_iter, search_space, f, c); }},
+        {"SCA", [&](const Objective& f, const auto& search_space, const SurrogateConfig& c) { return sca_surrogate(num_agents, max_iter, search_space, f, c); }},
+        {"TLBO", [&](const Objective& f, const auto& search_space, const SurrogateConfig& c) { return tlbo_surrogate(num_agents, max_iter, search_space, f, c); }},
+    };
+
+    std::ofstream outfile("surrogate.txt");
+    if (!outfile.is_open()) {
+        std::cerr << "Error opening surrogate.txt for writing" << std::endl;
+        return 1;
+    }
+    outfile << "Surrogate pre-screening, " << surrogate_config.evaluate_fraction * 100.0 << "% of each generation evaluated\n";
+    outfile << "saved %: evaluations saved; loss: mean best fitness screened - unscreened; model s: mean model time per run\n";
+    outfile << std::fixed << std::setprecision(2);
+    for (const auto& algorithm : algorithms)
+        outfile << std::setw(36) << algorithm.first;
+    outfile << '\n';
+
+    for (size_t config_idx = 0; config_idx < configs.size(); ++config_idx) {
+        const BenchmarkConfig& config = configs[config_idx];
+        outfile << config.benchmark->label() << ": ";
+        for (const auto& algorithm : algorithms) {
+            std::vector<double> savings, losses, model_seconds;
+            for (int run = 0; run < num_runs; ++run) {
+                seed_noise(static_cast<uint64_t>(run) + 1);
+                SurrogateComparison comparison = compare_surrogate(
+                    [&](const Objective& f, const SurrogateConfig& c) { return algorithm.second(f, config.search_space, c); },
+                    config.benchmark->function, surrogate_config, run_seed(config, run));
+                savings.push_back(comparison.evaluationSavings() * 100.0);
+                losses.push_back(comparison.fitnessLoss());
+                model_seconds.push_back(comparison.model_seconds);
+            }
+            outfile << "saved " << std::setw(5) << mean_value(savings) << " loss " << std::setw(9) << mean_value(losses)
+                    << " model " << std::setw(4) << mean_value(model_seconds) << " |";
+        }
+        outfile << '\n';
+    }
+    return 0;
+}
+
+// Many small runs (D = 10, 30 agents) of the ask/tell optimizers interleaved on pinned threads, with
+// the candidates of all runs of a benchmark evaluated in shared batches (see interleave.cpp)
+int write_interleaved_report(const std::vector<BenchmarkConfig>& configs, int num_runs, int num_threads) {
+    const int num_agents = 30, max_iter = 100;
+    const size_t num_dimensions = 10;
+    std::vector<std::pair<std::string, std::function<std::unique_ptr<AskTellOptimizer>(const std::vector<std::pair<double, double>>&)>>> algorithms = {
+        {"WOA", [&](const auto& search_space) { return std::make_unique<WoaAskTell>(num_agents, max_iter, search_space); }},
+        {"SCA", [&](const auto& search_space) { return std::make_unique<ScaAskTell>(num_agents, max_iter, search_space); }},
+        {"AOA", [&](const auto& search_space) { return std::make_unique<AoaAskTell>(num_agents, max_iter, search_space); }},
+        {"TLBO", [&](const auto& search_space) { return std::make_unique<TlboAskTell>(num_agents, max_iter, search_space); }},
+    };
+    if (num_threads <= 0) num_threads = static_cast<int>(TopologyExecutor().threadCount());
+
+    std::ofstream outfile("interleaved.txt");
+    if (!outfile.is_open()) {
+        std::cerr << "Error opening interleaved.txt for writing" << std::endl;
+        return 1;
+    }
+    outfile << num_runs << " interleaved runs per benchmark on " << num_threads << " threads, D = " << num_dimensions
+            << ", " << num_agents << " agents, " << max_iter << " iterations\n";
+    outfile << "mean best fitness / success rate, % / runs per second / mean batch size\n";
+    outfile << std::fixed << std::setprecision(2);
+    for (const auto& algorithm : algorithms)
+        outfile << std::setw(38) << algorithm.first;
+    outfile << '\n';
 
+    for (const BenchmarkConfig& config : configs) {
+        const BenchmarkInfo& benchmark = *config.benchmark;
+        // Noisy benchmarks: every run draws its own noise, seeded as in the sweep, and is batched alone
+        const bool noisy = benchmark.has(CapNoisy);
+        std::vector<std::pair<double, double>> search_space = benchmark.searchSpace(num_dimensions);
+        PopulationEvaluator evaluator = use_shift_rotation ? shift_rotated_evaluator(benchmark.id, num_dimensions, benchmark.upper)
+                                                           : population_evaluator(benchmark);
+        double optimum = known_optimum(benchmark, num_dimensions);
+        double target = std::isnan(optimum) || noisy || !stop_at_target ? -std::numeric_limits<double>::infinity()
+                                                                         : optimum + target_tolerance;
+
+        outfile << benchmark.label() << ": ";
+        for (const auto& algorithm : algorithms) {
+            InterleavedResult result = run_interleaved(
+                [&]() { return algorithm.second(search_space); }, evaluator, num_dimensions, num_runs,
+                [&](int run) { return run_seed(config, run); }, target, num_threads, 2048,
+                noisy ? std::function<uint64_t(int)>([](int run) { return static_cast<uint64_t>(run) + 1; }) : nullptr);
+            ErtStatistics ert;
+            for (int run = 0; run < num_runs; ++run) ert.add(result.evaluations[run], result.evaluations_to_target[run]);
+            outfile << std::setw(9) << mean_value(result.best_fitness) << " " << std::setw(6) << ert.successRate() * 100.0
+                    << " " << std::setw(9) << num_runs / result.seconds << " " << std::setw(7) << result.mean_batch_size << " |";
+        }
+        outfile << '\n';
+    }
+    return 0;
+}
+
+// WOA, SCA and AOA in the asynchronous steady-state mode (steady_state.cpp), one run per benchmark
+// at its default bounds and dimension with in_flight evaluations outstanding: on a pinned pool of
+// num_threads threads, or through `external_command <shm name>` (e.g. ./stub_evaluator, plain
+// benchmarks only) in batches of in_flight candidates
+int write_steady_state_report(const std::vector<BenchmarkConfig>& configs, int in_flight, int num_threads,
+                              const std::string& external_command) {
+    const int num_agents = 30, max_iter = 200;
+    const uint32_t external_slots = 4;
+    if (num_threads <= 0) num_threads = static_cast<int>(TopologyExecutor().threadCount());
+    std::vector<std::pair<std::string, std::function<std::unique_ptr<AskTellOptimizer>(const std::vector<std::pair<double, double>>&)>>> algorithms = {
+        {"WOA", [&](const auto& search_space) { return std::make_unique<WoaAskTell>(num_agents, max_iter, search_space); }},
+        {"SCA", [&](const auto& search_space) { return std::make_unique<ScaAskTell>(num_agents, max_iter, search_space); }},
+        {"AOA", [&](const auto& search_space) { return std::make_unique<AoaAskTell>(num_agents, max_iter, search_space); }},
+    };
+
+    std::ofstream outfile("steady_state.txt");
+    if (!outfile.is_open()) {
+        std::cerr << "Error opening steady_state.txt for writing" << std::endl;
+        return 1;
+    }
+    if (external_command.empty())
+        outfile << "Steady state, " << in_flight << " evaluations in flight on " << num_threads << " threads";
+    else
+        outfile << "Steady state through " << external_command << ", " << external_slots << " batches of " << in_flight << " in flight";
+    outfile << ", " << num_agents << " agents, " << max_iter << " iterations\n";
+    outfile << "best fitness / evaluations / seconds / utilization, %\n";
+    outfile << std::fixed << std::setprecision(2);
+    for (const auto& algorithm : algorithms)
+        outfile << std::setw(40) << algorithm.first;
+    outfile << '\n';
+
+    for (const BenchmarkConfig& config : configs) {
+        std::unique_ptr<EvalCache> cache = make_eval_cache(config);
+        Objective benchmark_function = configure_objective(config, cache.get());
+        outfile << config.benchmark->label() << ": ";
+        for (const auto& algorithm : algorithms) {
+            seed_noise(1);
+            seed_random(run_seed(config, 0));
+            set_run_target(run_target(config));
+            std::unique_ptr<AskTellOptimizer> optimizer = algorithm.second(config.search_space);
+            SteadyStateResult result;
+            if (external_command.empty()) {
+                result = run_steady_state(*optimizer, benchmark_function, num_threads, in_flight);
+            } else {
+                ExternalEvaluator evaluator(external_command, config.search_space.size(), in_flight, external_slots,
+                                            config.benchmark->id);
+                result = run_steady_state_external(*optimizer, evaluator);
+            }
+            outfile << std::scientific << std::setprecision(4) << std::setw(11) << result.best_fitness << std::fixed
+                    << std::setprecision(2) << " " << std::setw(7) << result.evaluations << " " << std::setw(7)
+                    << result.wall_seconds << " " << std::setw(6) << result.utilization * 100.0 << " |";
+        }
+        outfile << '\n';
+    }
+    return 0;
+}
+
+// One portfolio run per benchmark (portfolio.cpp) at its default bounds and dimension: the best
+// value, its time, and how the bandit shared the evaluations out
+int write_portfolio_report(const std::vector<BenchmarkConfig>& configs, long long max_evaluations, int num_threads) {
+    const int num_agents = 50;
+    if (num_threads <= 0) num_threads = static_cast<int>(TopologyExecutor().threadCount());
+
+    std::ofstream outfile("portfolio.txt");
+    if (!outfile.is_open()) {
+        std::cerr << "Error opening portfolio.txt for writing" << std::endl;
+        return 1;
+    }
+    outfile << "Portfolio of the six optimizers, " << max_evaluations << " evaluations per benchmark, " << num_threads
+            << " threads, " << num_agents << " agents\n";
+    outfile << "best fitness / seconds / seconds to the final best / share of the evaluations per optimizer, %\n";
+
+    for (const BenchmarkConfig& config : configs) {
+        std::unique_ptr<EvalCache> cache = make_eval_cache(config);
+        PortfolioSettings settings;
+        settings.max_evaluations = max_evaluations;
+        settings.num_threads = num_threads;
+        settings.seed = run_seed(config, 0);
+        settings.target = run_target(config);
+        seed_noise(1);
+        PortfolioResult result = run_portfolio(default_portfolio(num_agents, max_evaluations, config.search_space),
+                                               configure_objective(config, cache.get()), settings);
+
+        outfile << config.benchmark->label() << ": " << std::scientific << std::setprecision(4) << result.best_fitness
+                << std::fixed << std::setprecision(2) << " " << result.seconds << " "
+                << (result.best_over_time.empty() ? 0.0 : result.best_over_time.back().first) << " |";
+        for (const PortfolioMemberStats& member : result.members)
+            outfile << " " << member.name << " " << 100.0 * member.evaluations / std::max(1LL, result.evaluations);
+        outfile << '\n';
+    }
     return 0;
 }
+
+// Usage:
+//   main                                  all runs in this process
+//   main --threads N                      N pinned threads in this process (0: one per CPU)
+//   main --threads N --memory-budget MB   start runs only while their estimated memory fits (0: no limit)
+//   main --workers N [--socket PATH]      coordinator with N local worker processes
+//   main --worker PATH                    extra worker for a coordinator listening on PATH
+//   main --benchmarks SPEC                only these benchmarks, e.g. "f1,f9", "separable", "all,!noisy"
+//                                         (remote workers need the same option)
+//   main --surrogate N                    surrogate pre-screening report over N runs (surrogate.txt)
+//   main --interleaved N [--threads T]    N small runs per benchmark interleaved in batches (interleaved.txt)
+//   main --portfolio EVALS [--threads T]  the six optimizers as one bandit-driven portfolio per benchmark,
+//                                         EVALS evaluations each (portfolio.txt)
+//   main --steady-state IN_FLIGHT [--threads T] [--external COMMAND]
+//                                         WOA/SCA/AOA keeping IN_FLIGHT evaluations outstanding, on T threads
+//                                         or through an evaluator process (steady_state.txt)
+//   main --snapshots DIR                  serial runs snapshot every 100 iterations to DIR and resume from it
+//   main --init METHOD                    initial populations: uniform (default), sobol, halton, lhs
+//   main --elites DIR                     warm start from the elites of earlier runs kept in DIR
+//   main --metrics-socket PATH            live progress of the runs in this process on a Unix socket
+//   main --metrics-port PORT              ... and/or over HTTP on 127.0.0.1:PORT (see metrics.cpp)
+//   main --dashboard SECONDS              redraw a progress table on the terminal (stderr) at this interval
+//   main --diversity MODE                 WOA/SCA population diversity: off (default), monitor, ipop (restarts)
+//   main --stagnation ITERATIONS          iterations without improvement before an ipop restart (default 100)
+//   main --lockstep on                    serial mode: the repetitions of WOA/SCA/AOA in lock step (lockstep.cpp)
+//   main --ssa-scan CHUNKS                serial mode: SSA as a scan over CHUNKS chunks with batch evaluation (ssa_scan.cpp)
+int main(int argc, char** argv) {
+    const int num_runs = 30;
+
+    int num_workers = 0;
+    int num_threads = -1;
+    std::string socket_path = "/tmp/metaheuristics_sweep.sock";
+    std::string worker_socket;
+    int surrogate_runs = 0;
+    int interleaved_runs = 0;
+    long long portfolio_evaluations = 0;
+    int steady_state_in_flight = 0;
+    std::string external_command;
+    MetricsSettings metrics_settings;
+    metrics_settings.dashboard_interval = 0.0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string option = argv[i];
+        if (option == "--workers") num_workers = std::stoi(argv[i + 1]);
+        else if (option == "--threads") num_threads = std::stoi(argv[i + 1]);
+        else if (option == "--socket") socket_path = argv[i + 1];
+        else if (option == "--worker") worker_socket = argv[i + 1];
+        else if (option == "--benchmarks") benchmark_selection = argv[i + 1];
+        else if (option == "--surrogate") surrogate_runs = std::stoi(argv[i + 1]);
+        else if (option == "--interleaved") interleaved_runs = std::stoi(argv[i + 1]);
+        else if (option == "--snapshots") snapshot_dir = argv[i + 1];
+        else if (option == "--portfolio") portfolio_evaluations = std::stoll(argv[i + 1]);
+        else if (option == "--steady-state") steady_state_in_flight = std::stoi(argv[i + 1]);
+        else if (option == "--external") external_command = argv[i + 1];
+        else if (option == "--init") init_method = init_method_from_name(argv[i + 1]);
+        else if (option == "--elites") elite_dir = argv[i + 1];
+        else if (option == "--metrics-socket") metrics_settings.socket_path = argv[i + 1];
+        else if (option == "--metrics-port") metrics_settings.http_port = std::stoi(argv[i + 1]);
+        else if (option == "--dashboard") metrics_settings.dashboard_interval = std::stod(argv[i + 1]);
+        else if (option == "--diversity") {
+            run_diversity.monitor = std::string(argv[i + 1]) != "off";
+            run_diversity.restart = std::string(argv[i + 1]) == "ipop";
+        }
+        else if (option == "--stagnation") run_diversity.stagnation_iterations = std::stoi(argv[i + 1]);
+        else if (option == "--lockstep") use_lockstep_runs = std::string(argv[i + 1]) == "on";
+        else if (option == "--ssa-scan") ssa_scan_chunks = std::stoul(argv[i + 1]);
+        else if (option == "--memory-budget") {
+            memory_budget_fraction = 0.0;
+            memory_budget_bytes = static_cast<size_t>(std::stod(argv[i + 1]) * 1048576.0);
+        }
+    }
+    if (memory_budget_fraction > 0.0)
+        memory_budget_bytes = static_cast<size_t>(memory_budget_fraction * available_memory());
+
+    try {
+        select_benchmarks(benchmark_selection);
+    } catch (const std::invalid_argument& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    // Runs of this process only; a --worker has its own endpoint if given one
+    std::unique_ptr<MetricsSampler> metrics;
+    if (!metrics_settings.socket_path.empty() || metrics_settings.http_port > 0 || metrics_settings.dashboard_interval > 0.0)
+        metrics = std::make_unique<MetricsSampler>(metrics_settings);
+
+    if (!worker_socket.empty())
+        return run_worker(worker_socket, run_sweep_job);
+
+    std::vector<BenchmarkConfig> configs = benchmark_configs();
+    if (surrogate_runs > 0)
+        return write_surrogate_report(configs, surrogate_runs);
+    if (interleaved_runs > 0)
+        return write_interleaved_report(configs, interleaved_runs, num_threads);
+    if (portfolio_evaluations > 0)
+        return write_portfolio_report(configs, portfolio_evaluations, num_threads);
+    if (steady_state_in_flight > 0) {
+        try {
+            return write_steady_state_report(configs, steady_state_in_flight, num_threads, external_command);
+        } catch (const std::exception& error) {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+    }
+    if (record_convergence)
+        unlink(convergence_path); // curves of this sweep only
+
+    std::vector<AlgorithmEntry> algorithms = algorithm_table();
+    std::vector<std::vector<vector<double>>> all_algorithm_results;
+    std::map<int, double> node_throughput;
+
+    if (num_threads >= 0) {
+        all_algorithm_results = run_threaded(num_threads, num_runs, algorithms, configs, node_throughput);
+    } else if (num_workers > 0) {
+        all_algorithm_results = run_sharded(socket_path, num_workers, num_runs, algorithms.size(), configs.size(),
+                                             worker_command(argc, argv));
+    } else {
+        for (uint32_t a = 0; a < algorithms.size(); ++a) {
+            LockstepAlgorithm lockstep;
+            if (use_lockstep_runs && lockstep_form(algorithms[a].name, lockstep))
+                all_algorithm_results.push_back(run_lockstep_and_evaluate(lockstep, num_runs, configs));
+            else if (ssa_scan_chunks > 0 && algorithms[a].name == "SSA")
+                all_algorithm_results.push_back(run_ssa_scan_and_evaluate(ssa_scan_chunks, num_runs, configs));
+            else
+                all_algorithm_results.push_back(run_and_evaluate(algorithms[a].name, algorithms[a].run, num_runs, configs, a));
+        }
+    }
+
+    sweep_elites.save(configs);
+    return write_results(algorithms, all_algorithm_results, configs, node_throughput);
+}
@@ -5,13 +5,19 @@
 #include <iomanip>
 #include "SSA2.0.cpp"
 #include "benchmarks.h"
+#include "registry.cpp"
 #include <fstream>
 
 using namespace std;
 
+// Progress of the runs (metrics.cpp): dashboard on a terminal, endpoints if set
+const char* const metrics_socket_path = ""; // e.g. "/tmp/metaheuristics_metrics.sock"
+const int metrics_http_port = 0;            // e.g. 9464
+
 struct BenchmarkConfig {
     double (*benchmark_func)(const std::vector<double>&);
     std::vector<std::pair<double, double>> search_space;
+    double target; // stop once reached (see termination.cpp)
 };
 
 template <typename AlgorithmFunc>
@@ -66,28 +72,14 @@ std::pair<std::vector<double>, double> ssa_with_logging(int num_salps, int max_i
 
 int main() {
     const int num_runs = 30;
+    MetricsSampler metrics({metrics_socket_path, metrics_http_port});
 
-    std::vector<BenchmarkConfig> configs = {
-            {f1, std::vector<std::pair<double, double>>(20, {-100.0, 100.0})},
-            {f2, std::vector<std::pair<double, double>>(20, {-10.0, 10.0})},
-            {f3, std::vector<std::pair<double, double>>(20, {-100.0, 100.0})},
-            {f4, std::vector<std::pair<double, double>>(20, {-100.0, 100.0})},
-            {f5, std::vector<std::pair<double, double>>(20, {-30,30})},
-            {f6, std::vector<std::pair<double, double>>(20, {-10.0, 10.0})},
-            {f7, std::vector<std::pair<double, double>>(20, {-1.28,1.28})},
-            {f8, std::vector<std::pair<double, double>>(20, {-500,500})},
-            {f9, std::vector<std::pair<double, double>>(20, {-5.12,5.12})},
-            {f10, std::vector<std::pair<double, double>>(20, {-32,32})},
-            {f11, std::vector<std::pair<double, double>>(20, {-600,600})},
-            {f12, std::vector<std::pair<double, double>>(20, {-50,50})},
-            {f13, std::vector<std::pair<double, double>>(20, {-50,50})},
-            {f14, std::vector<std::pair<double, double>>(10, {-5,5})},
-            {f15, std::vector<std::pair<double, double>>(10, {-5,5})},
-            {f16, std::vector<std::pair<double, double>>(10, {-5,5})},
-            {f17, std::vector<std::pair<double, double>>(10, {-5,5})},
-            {f18, std::vector<std::  pair<double, double>>(10, {-5,5})},
-            {f19, std::vector<std::pair<double, double>>(10, {-5,5})},
-    };
+    std::vector<BenchmarkConfig> configs;
+    for (const BenchmarkInfo& benchmark : benchmark_registry()) {
+        double optimum = benchmark.optimumFor(benchmark.dims);
+        double target = std::isnan(optimum) || benchmark.has(CapNoisy) ? -std::numeric_limits<double>::infinity() : optimum + 1e-8;
+        configs.push_back({benchmark.function, benchmark.searchSpace(), target});
+    }
 
     ofstream main_out("results.txt", ios::app);
     for (size_t config_idx = 0; config_idx < configs.size(); ++config_idx) {
@@ -95,6 +87,7 @@ int main() {
         auto& search_space = configs[config_idx].search_space;
 
         main_out << "Testing on f" << config_idx + 1 << ":\n";
+        set_run_target(configs[config_idx].target);
         auto [solution, fitness] = ssa_with_logging(100, 3000, search_space, benchmark_function, config_idx + 1);
         main_out << "\n";
     }
@@ -0,0 +1,132 @@
+#pragma once
+#include <new>
+#include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <malloc.h>
+#include "benchmarks.h"
+
+// Memory accounting of the runs.
+// The global operator new/delete are replaced by versions that count the usable size of every
+// block on the allocating thread. A run executes on one thread, so the population, its copies
+// (ICA's empires and colonies, TLBO's difference vectors) and every scratch vector land in that
+// thread's account. Blocks freed by another thread than the one that allocated them move bytes
+// between accounts; the runs never do that with their own buffers.
+//
+// Include this file in exactly one translation unit (the program's main file).
+
+struct MemoryAccount {
+    int64_t live = 0; // bytes currently allocated by this thread
+    int64_t peak = 0; // highest live since the last reset
+    // Live bytes sampled at every evaluation of memory_objective
+    double sampled = 0.0;
+    uint64_t samples = 0;
+};
+
+inline thread_local MemoryAccount memory_account;
+
+// Out of line: inlined into the replaced operators, GCC would see malloc and free paired with
+// new and delete and warn about mismatched allocation functions (-Wmismatched-new-delete)
+[[gnu::noinline]] void* trackedAllocate(size_t size, size_t alignment) noexcept {
+    void* block = nullptr;
+    if (alignment <= alignof(std::max_align_t)) {
+        block = std::malloc(size ? size : 1);
+    } else if (posix_memalign(&block, alignment, size ? size : 1) != 0) {
+        block = nullptr;
+    }
+    if (!block) return nullptr;
+    memory_account.live += malloc_usable_size(block);
+    if (memory_account.live > memory_account.peak) memory_account.peak = memory_account.live;
+    return block;
+}
+
+[[gnu::noinline]] void trackedFree(void* block) noexcept {
+    if (!block) return;
+    memory_account.live -= malloc_usable_size(block);
+    std::free(block);
+}
+
+void* checkedAllocate(size_t size, size_t alignment) {
+    void* block = trackedAllocate(size, alignment);
+    if (!block) throw std::bad_alloc();
+    return block;
+}
+
+constexpr size_t default_alignment = alignof(std::max_align_t);
+
+void* operator new(size_t size) { return checkedAllocate(size, default_alignment); }
+void* operator new[](size_t size) { return checkedAllocate(size, default_alignment); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size, default_alignment); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size, default_alignment); }
+void operator delete(void* block) noexcept { trackedFree(block); }
+void operator delete[](void* block) noexcept { trackedFree(block); }
+void operator delete(void* block, size_t) noexcept { trackedFree(block); }
+void operator delete[](void* block, size_t) noexcept { trackedFree(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept { trackedFree(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept { trackedFree(block); }
+
+// Over-aligned types (alignas above 16) come through these; posix_memalign blocks are freed by free
+void* operator new(size_t size, std::align_val_t alignment) { return checkedAllocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return checkedAllocate(size, static_cast<size_t>(alignment)); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedAllocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedAllocate(size, static_cast<size_t>(alignment));
+}
+void operator delete(void* block, std::align_val_t) noexcept { trackedFree(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { trackedFree(block); }
+void operator delete(void* block, size_t, std::align_val_t) noexcept { trackedFree(block); }
+void operator delete[](void* block, size_t, std::align_val_t) noexcept { trackedFree(block); }
+void operator delete(void* block, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(block); }
+void operator delete[](void* block, std::align_val_t, const std::nothrow_t&) noexcept { trackedFree(block); }
+
+// Footprint of one run: bytes above what the thread held when the run started
+struct RunMemory {
+    uint64_t peak_bytes = 0;
+    uint64_t steady_bytes = 0; // mean live bytes over the evaluations: population and scratch in use
+};
+
+// Measures the run between construction and finish() on the calling thread
+class MemoryScope {
+public:
+    MemoryScope() : base(memory_account.live) {
+        memory_account.peak = base;
+        memory_account.sampled = 0.0;
+        memory_account.samples = 0;
+    }
+
+    RunMemory finish() const {
+        RunMemory memory;
+        memory.peak_bytes = static_cast<uint64_t>(std::max<int64_t>(0, memory_account.peak - base));
+        if (memory_account.samples > 0)
+            memory.steady_bytes = static_cast<uint64_t>(std::max(0.0, memory_account.sampled / memory_account.samples - base));
+        return memory;
+    }
+
+private:
+    int64_t base;
+};
+
+// Samples the live bytes of the thread at every evaluation
+Objective memory_objective(Objective benchmark_function) {
+    return [benchmark_function = std::move(benchmark_function)](const std::vector<double>& position) {
+        memory_account.sampled += static_cast<double>(memory_account.live);
+        ++memory_account.samples;
+        return benchmark_function(position);
+    };
+}
+
+// MemAvailable of /proc/meminfo in bytes, 0 if unknown
+uint64_t available_memory() {
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    uint64_t kilobytes;
+    std::string unit;
+    while (meminfo >> key >> kilobytes >> unit)
+        if (key == "MemAvailable:") return kilobytes * 1024;
+    return 0;
+}
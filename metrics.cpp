@@ -0,0 +1,330 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <limits>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "benchmarks.h"
+#include "sweep.cpp"
+
+// Live progress of running optimizers.
+// Every run holds a slot of a fixed board (RunProgress) and writes its iteration, evaluations and
+// best fitness into it with relaxed atomic stores; nothing else happens on the optimizer's
+// thread. A sampler thread (MetricsSampler) reads the board a few times per second, derives
+// evaluations per second and serves the numbers in Prometheus text format on a Unix socket
+// (`socat - UNIX-CONNECT:PATH`) and/or over HTTP on 127.0.0.1 (`curl 127.0.0.1:PORT/metrics`).
+// On a terminal it redraws a one-line-per-run dashboard on stderr at most once per
+// dashboard_interval.
+
+struct alignas(64) RunMetrics {
+    // Odd while a run owns the slot; changes on open and close, so a reader can tell that the
+    // values it read belong to one run
+    std::atomic<uint64_t> generation{0};
+    std::atomic<const char*> algorithm{""}; // must outlive the process's runs (literal, table entry)
+    std::atomic<int> benchmark{0};
+    std::atomic<long long> iteration{0};
+    std::atomic<uint64_t> evaluations{0};
+    std::atomic<double> best_fitness{std::numeric_limits<double>::infinity()};
+    std::atomic<int64_t> start_ns{0};
+
+    // Hot loop: relaxed stores only (one writer per slot)
+    void report(long long t, uint64_t evaluation_count, double best) {
+        iteration.store(t, std::memory_order_relaxed);
+        evaluations.store(evaluation_count, std::memory_order_relaxed);
+        best_fitness.store(best, std::memory_order_relaxed);
+    }
+
+    // One more evaluation with this value (metered_objective)
+    void evaluated(double value) {
+        evaluations.store(evaluations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (value < best_fitness.load(std::memory_order_relaxed)) best_fitness.store(value, std::memory_order_relaxed);
+    }
+};
+
+struct MetricsSample {
+    size_t slot;
+    uint64_t generation;
+    std::string algorithm;
+    int benchmark;
+    long long iteration;
+    uint64_t evaluations;
+    double best_fitness;
+    double seconds; // since the run started
+    double evaluations_per_second = 0.0;
+};
+
+inline int64_t metrics_clock_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class MetricsBoard {
+public:
+    static constexpr size_t max_runs = 256;
+
+    // Claims a free slot; nullptr if all are taken (the run is then not shown)
+    RunMetrics* open(const char* algorithm, int benchmark) {
+        for (size_t s = 0; s < max_runs; ++s) {
+            bool expected = false;
+            if (!claimed[s].compare_exchange_strong(expected, true, std::memory_order_acquire)) continue;
+            RunMetrics& slot = slots[s];
+            slot.algorithm.store(algorithm, std::memory_order_relaxed);
+            slot.benchmark.store(benchmark, std::memory_order_relaxed);
+            slot.report(0, 0, std::numeric_limits<double>::infinity());
+            slot.start_ns.store(metrics_clock_ns(), std::memory_order_relaxed);
+            slot.generation.fetch_add(1, std::memory_order_release);
+            return &slot;
+        }
+        return nullptr;
+    }
+
+    void close(RunMetrics* slot) {
+        slot->generation.fetch_add(1, std::memory_order_release);
+        claimed[slot - slots.data()].store(false, std::memory_order_release);
+    }
+
+    // The runs in progress; evaluations_per_second is left to the caller
+    std::vector<MetricsSample> sample() const {
+        std::vector<MetricsSample> samples;
+        int64_t now = metrics_clock_ns();
+        for (size_t s = 0; s < max_runs; ++s) {
+            const RunMetrics& slot = slots[s];
+            uint64_t generation = slot.generation.load(std::memory_order_acquire);
+            if (!(generation & 1)) continue;
+            MetricsSample sample{s, generation, slot.algorithm.load(std::memory_order_relaxed),
+                                 slot.benchmark.load(std::memory_order_relaxed), slot.iteration.load(std::memory_order_relaxed),
+                                 slot.evaluations.load(std::memory_order_relaxed), slot.best_fitness.load(std::memory_order_relaxed),
+                                 (now - slot.start_ns.load(std::memory_order_relaxed)) * 1e-9};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.generation.load(std::memory_order_relaxed) != generation) continue; // closed meanwhile
+            samples.push_back(sample);
+        }
+        return samples;
+    }
+
+private:
+    std::array<RunMetrics, max_runs> slots;
+    std::array<std::atomic<bool>, max_runs> claimed{};
+};
+
+// Board of the process
+MetricsBoard& metrics_board() {
+    static MetricsBoard board;
+    return board;
+}
+
+// Slot of the run on this thread, for metered_objective
+inline thread_local RunMetrics* run_metrics = nullptr;
+
+// A run's slot for its lifetime; also the thread's run_metrics
+class RunProgress {
+public:
+    RunProgress(const char* algorithm, int benchmark) : slot(metrics_board().open(algorithm, benchmark)) {
+        previous = run_metrics;
+        run_metrics = slot;
+    }
+
+    ~RunProgress() {
+        run_metrics = previous;
+        if (slot) metrics_board().close(slot);
+    }
+
+    RunProgress(const RunProgress&) = delete;
+    RunProgress& operator=(const RunProgress&) = delete;
+
+    void report(long long iteration, uint64_t evaluations, double best_fitness) {
+        if (slot) slot->report(iteration, evaluations, best_fitness);
+    }
+
+private:
+    RunMetrics* slot;
+    RunMetrics* previous;
+};
+
+// Counts evaluations and the best value into the slot of the current run (if any)
+Objective metered_objective(Objective benchmark_function) {
+    return [benchmark_function = std::move(benchmark_function)](const std::vector<double>& position) {
+        double value = benchmark_function(position);
+        if (RunMetrics* slot = run_metrics) slot->evaluated(value);
+        return value;
+    };
+}
+
+struct MetricsSettings {
+    std::string socket_path;         // Unix socket, empty: none
+    int http_port = 0;               // HTTP on 127.0.0.1, 0: none
+    double dashboard_interval = 1.0; // seconds between redraws on a terminal, 0: no dashboard
+    double sample_interval = 0.25;   // seconds between samples
+};
+
+class MetricsSampler {
+public:
+    explicit MetricsSampler(MetricsSettings settings) : settings(std::move(settings)) {
+        if (!this->settings.socket_path.empty()) socket_fd = listenUnix(this->settings.socket_path);
+        if (this->settings.http_port > 0) http_fd = listenLoopback(this->settings.http_port);
+        dashboard = this->settings.dashboard_interval > 0.0 && isatty(fileno(stderr));
+        sampler = std::thread([this]() { loop(); });
+    }
+
+    ~MetricsSampler() {
+        stopping.store(true);
+        sampler.join();
+        if (dashboard && dashboard_lines > 0) std::cerr << "\x1b[" << dashboard_lines << "F\x1b[J" << std::flush;
+        if (socket_fd >= 0) {
+            close(socket_fd);
+            unlink(settings.socket_path.c_str());
+        }
+        if (http_fd >= 0) close(http_fd);
+    }
+
+    // Prometheus text format of the runs in progress
+    static std::string exposition(const std::vector<MetricsSample>& samples) {
+        std::ostringstream out;
+        out.precision(10);
+        auto series = [&](const char* name, const char* type, const char* help, auto value) {
+            out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+            for (const MetricsSample& s : samples)
+                out << name << "{slot=\"" << s.slot << "\",algorithm=\"" << s.algorithm << "\",benchmark=\"f" << s.benchmark
+                    << "\"} " << value(s) << '\n';
+        };
+        out << "# HELP optimizer_runs Runs in progress\n# TYPE optimizer_runs gauge\noptimizer_runs " << samples.size() << '\n';
+        series("optimizer_iteration", "gauge", "Current iteration", [](const MetricsSample& s) { return s.iteration; });
+        series("optimizer_evaluations_total", "counter", "Objective evaluations", [](const MetricsSample& s) { return s.evaluations; });
+        series("optimizer_best_fitness", "gauge", "Best fitness so far", [](const MetricsSample& s) { return s.best_fitness; });
+        series("optimizer_evaluations_per_second", "gauge", "Evaluations per second over the last sample",
+               [](const MetricsSample& s) { return s.evaluations_per_second; });
+        series("optimizer_run_seconds", "gauge", "Seconds since the run started", [](const MetricsSample& s) { return s.seconds; });
+        return out.str();
+    }
+
+private:
+    static int listenUnix(const std::string& path) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address = socketAddress(path);
+        unlink(path.c_str());
+        if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, 16) != 0) {
+            std::cerr << "Metrics: cannot listen on " << path << ": " << std::strerror(errno) << std::endl;
+            if (fd >= 0) close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    static int listenLoopback(int port) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        int on = 1;
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (fd >= 0) setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, 16) != 0) {
+            std::cerr << "Metrics: cannot listen on 127.0.0.1:" << port << ": " << std::strerror(errno) << std::endl;
+            if (fd >= 0) close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    void loop() {
+        auto last_draw = std::chrono::steady_clock::now() - std::chrono::hours(1);
+        while (!stopping.load()) {
+            std::vector<MetricsSample> samples = sampleWithRates();
+            std::string text = exposition(samples);
+
+            auto now = std::chrono::steady_clock::now();
+            if (dashboard && std::chrono::duration<double>(now - last_draw).count() >= settings.dashboard_interval) {
+                draw(samples);
+                last_draw = now;
+            }
+
+            // Serve connections until the next sample is due
+            std::vector<pollfd> fds;
+            if (socket_fd >= 0) fds.push_back({socket_fd, POLLIN, 0});
+            if (http_fd >= 0) fds.push_back({http_fd, POLLIN, 0});
+            int timeout_ms = static_cast<int>(settings.sample_interval * 1000);
+            if (fds.empty()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+                continue;
+            }
+            if (poll(fds.data(), fds.size(), timeout_ms) <= 0) continue;
+            for (const pollfd& p : fds) {
+                if (!(p.revents & POLLIN)) continue;
+                int client = accept(p.fd, nullptr, nullptr);
+                if (client < 0) continue;
+                if (p.fd == http_fd) serveHttp(client, text);
+                else writeAll(client, text.data(), text.size());
+                close(client);
+            }
+        }
+    }
+
+    // Answers any request with the metrics; a client gets 100 ms to send its request line
+    static void serveHttp(int client, const std::string& text) {
+        pollfd p{client, POLLIN, 0};
+        char request[1024];
+        if (poll(&p, 1, 100) > 0) recv(client, request, sizeof(request), 0);
+        std::string response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                               std::to_string(text.size()) + "\r\nConnection: close\r\n\r\n" + text;
+        writeAll(client, response.data(), response.size());
+    }
+
+    // Board sample with evaluations per second since the previous sample of the same run
+    std::vector<MetricsSample> sampleWithRates() {
+        std::vector<MetricsSample> samples = metrics_board().sample();
+        for (MetricsSample& s : samples) {
+            Previous& previous = previous_samples[s.slot];
+            if (previous.generation == s.generation && s.seconds > previous.seconds)
+                s.evaluations_per_second = (s.evaluations - previous.evaluations) / (s.seconds - previous.seconds);
+            else if (s.seconds > 0.0)
+                s.evaluations_per_second = s.evaluations / s.seconds;
+            previous = {s.generation, s.evaluations, s.seconds};
+        }
+        return samples;
+    }
+
+    void draw(const std::vector<MetricsSample>& samples) {
+        std::ostringstream out;
+        if (dashboard_lines > 0) out << "\x1b[" << dashboard_lines << "F\x1b[J"; // back to the top of the last frame
+        char line[160];
+        std::snprintf(line, sizeof(line), "%-4s %-8s %-5s %10s %14s %14s %12s\n", "slot", "algo", "bench", "iteration",
+                      "evaluations", "best", "evals/s");
+        out << line;
+        for (const MetricsSample& s : samples) {
+            std::snprintf(line, sizeof(line), "%-4zu %-8s f%-4d %10lld %14llu %14.6g %12.0f\n", s.slot, s.algorithm.c_str(),
+                          s.benchmark, s.iteration, static_cast<unsigned long long>(s.evaluations), s.best_fitness,
+                          s.evaluations_per_second);
+            out << line;
+        }
+        dashboard_lines = static_cast<int>(samples.size()) + 1;
+        std::cerr << out.str() << std::flush;
+    }
+
+    struct Previous {
+        uint64_t generation = 0;
+        uint64_t evaluations = 0;
+        double seconds = 0.0;
+    };
+
+    MetricsSettings settings;
+    int socket_fd = -1;
+    int http_fd = -1;
+    bool dashboard = false;
+    int dashboard_lines = 0;
+    std::array<Previous, MetricsBoard::max_runs> previous_samples{};
+    std::atomic<bool> stopping{false};
+    std::thread sampler;
+};
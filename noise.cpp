@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <cmath>
+
+// Noise source for noisy benchmarks (f7).
+// Instead of the global rand(), every evaluation draws from its own stream derived from the
+// run seed and a per-thread call counter: no lock, no shared state, reproducible for a fixed seed.
+
+inline uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+struct NoiseStream {
+    uint64_t state;
+
+    explicit NoiseStream(uint64_t seed) : state(seed) {}
+
+    // Uniform value in [0, 1) built from the top 53 bits
+    double next() {
+        state += 0x9E3779B97F4A7C15ULL;
+        return static_cast<double>(splitmix64(state) >> 11) * 0x1.0p-53;
+    }
+};
+
+struct NoiseContext {
+    uint64_t seed = 0;
+    uint64_t calls = 0;
+};
+
+inline thread_local NoiseContext noise_context;
+
+// Resets the noise of the calling thread; runs seeded identically see identical noise
+void seed_noise(uint64_t seed) {
+    noise_context.seed = seed;
+    noise_context.calls = 0;
+}
+
+// Stream for the next evaluation on this thread
+NoiseStream next_noise_stream() {
+    return NoiseStream(splitmix64(noise_context.seed ^ splitmix64(++noise_context.calls)));
+}
+
+// Result of replicated sampling of a noisy objective at one point
+struct NoisySample {
+    double mean;
+    double variance; // unbiased sample variance, 0 for a single replica
+    int replicas;
+};
+
+// Noisy benchmark split into the deterministic part and the additive noise term,
+// so replicated sampling pays for the deterministic part only once
+struct NoisyBenchmark {
+    double (*deterministic)(const std::vector<double>&);
+    double (*noise)(const std::vector<double>&, NoiseStream&);
+};
+
+NoisySample evaluate_replicated(const NoisyBenchmark& benchmark, const std::vector<double>& position, int replicas) {
+    double base = benchmark.deterministic(position);
+    NoiseStream stream = next_noise_stream();
+
+    // Welford's running mean / variance over the noise draws
+    double mean = 0.0;
+    double m2 = 0.0;
+    for (int r = 0; r < replicas; ++r) {
+        double value = base + benchmark.noise(position, stream);
+        double delta = value - mean;
+        mean += delta / (r + 1);
+        m2 += delta * (value - mean);
+    }
+    return {mean, replicas > 1 ? m2 / (replicas - 1) : 0.0, replicas};
+}
@@ -0,0 +1,389 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <string>
+#include <functional>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <numeric>
+#include <limits>
+#include <cstring>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "SSA.cpp"
+#include "ICA.cpp"
+#include "TLBO.cpp"
+#include "SCA.cpp"
+#include "AOA.cpp"
+#include "WOA.cpp"
+#include "benchmarks.h"
+#include "registry.cpp"
+#include "termination.cpp"
+#include "topology.cpp"
+
+// Performance regression harness.
+// Runs a fixed, seeded set of (algorithm, benchmark, dimension) jobs, each repeated several
+// times in a forked child pinned to one CPU, and measures evaluations per second, nanoseconds
+// per iteration and peak RSS. Every repetition does exactly the same work (same seed, no
+// target), so the spread is measurement noise only. Results go to a baseline file; two files
+// (e.g. from two builds) are compared metric by metric with Welch's t-test.
+//
+//   g++ -std=c++17 -O2 perf_regression.cpp -o perf_regression -pthread
+//   perf_regression --out FILE [--reps N] [--cpu N]     measure and write FILE
+//   perf_regression --out FILE --baseline OLD           measure, write FILE and compare with OLD
+//   perf_regression --compare OLD NEW                   compare two stored files
+//   perf_regression --check-kernels                     compare the raw-array kernels with the std::pow versions
+// Exit code 2 if a significant regression (or a kernel out of tolerance) was found.
+
+using PerfAlgorithm = std::function<void(const Objective&, const std::vector<std::pair<double, double>>&, int max_iter)>;
+
+struct PerfJob {
+    std::string algorithm;
+    std::string benchmark; // registry label
+    size_t dims;
+};
+
+const int perf_agents = 50;
+const int perf_iterations = 1000;
+
+std::map<std::string, PerfAlgorithm> perf_algorithms() {
+    return {
+        {"WOA", [](const Objective& f, const auto& space, int max_iter) { woa(perf_agents, max_iter, space, f); }},
+        {"AOA", [](const Objective& f, const auto& space, int max_iter) { aoa(perf_agents, max_iter, space, f); }},
+        {"SSA", [](const Objective& f, const auto& space, int max_iter) { ssa(perf_agents, max_iter, space, f); }},
+        {"ICA", [](const Objective& f, const auto& space, int max_iter) { ica(perf_agents, max_iter, space, 10, f); }},
+        {"TLBO", [](const Objective& f, const auto& space, int max_iter) { tlbo(perf_agents, max_iter, space, f); }},
+        {"SCA", [](const Objective& f, const auto& space, int max_iter) { sca(perf_agents, max_iter, space, f); }},
+    };
+}
+
+// Cheap, medium and composite benchmarks at a small and a large dimension
+std::vector<PerfJob> perf_jobs() {
+    std::vector<PerfJob> jobs;
+    for (const auto& algorithm : perf_algorithms())
+        for (const char* benchmark : {"f1", "f10", "f18"})
+            for (size_t dims : {10, 50})
+                jobs.push_back({algorithm.first, benchmark, dims});
+    return jobs;
+}
+
+// Metric -> samples, one per repetition
+using PerfSamples = std::map<std::string, std::vector<double>>;
+
+const char* const perf_metrics[] = {"evals_per_sec", "ns_per_iteration", "peak_rss_kb"};
+
+// Which direction is worse for a metric
+bool higherIsBetter(const std::string& metric) {
+    return metric == "evals_per_sec";
+}
+
+// Smallest relative change worth reporting. Peak RSS is nearly constant between repetitions but
+// moves by a few pages with the allocator and the environment, so it needs a coarser threshold.
+double minimumChange(const std::string& metric, double min_change) {
+    return metric == "peak_rss_kb" ? std::max(min_change, 0.10) : min_change;
+}
+
+// One repetition in a child process pinned to `cpu`; RSS comes from the child's own rusage
+bool measureRepetition(const PerfJob& job, int cpu, PerfSamples& samples) {
+    int channel[2];
+    if (pipe(channel) != 0) return false;
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(channel[0]);
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        sched_setaffinity(0, sizeof(set), &set);
+
+        const BenchmarkInfo* benchmark = find_benchmark(job.benchmark);
+        Objective objective = controlled_objective(benchmark->function);
+        std::vector<std::pair<double, double>> search_space = benchmark->searchSpace(job.dims);
+        set_run_target(-std::numeric_limits<double>::infinity());
+        seed_random(splitmix64(static_cast<uint64_t>(benchmark->id) * 1000003 + job.dims));
+
+        auto start_time = std::chrono::steady_clock::now();
+        perf_algorithms()[job.algorithm](objective, search_space, perf_iterations);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        double measured[2] = {run_control.evaluations / seconds, seconds * 1e9 / perf_iterations};
+        ssize_t written = write(channel[1], measured, sizeof(measured));
+        _exit(written == sizeof(measured) ? 0 : 1);
+    }
+    close(channel[1]);
+    double measured[2];
+    bool ok = pid > 0 && read(channel[0], measured, sizeof(measured)) == sizeof(measured);
+    close(channel[0]);
+
+    int status = 0;
+    rusage usage{};
+    if (pid > 0) wait4(pid, &status, 0, &usage);
+    if (!ok || !WIFEXITED(status) || WEXITSTATUS(status) != 0) return false;
+    samples["evals_per_sec"].push_back(measured[0]);
+    samples["ns_per_iteration"].push_back(measured[1]);
+    samples["peak_rss_kb"].push_back(static_cast<double>(usage.ru_maxrss));
+    return true;
+}
+
+std::string jobKey(const PerfJob& job) {
+    return job.algorithm + " " + job.benchmark + " " + std::to_string(job.dims);
+}
+
+// File format: one line per job and metric, "<algorithm> <benchmark> <dims> <metric> <n> <samples...>"
+bool write_perf_results(const std::string& path, const std::map<std::string, PerfSamples>& results) {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+    out << std::setprecision(10);
+    for (const auto& [key, samples] : results)
+        for (const auto& [metric, values] : samples) {
+            out << key << " " << metric << " " << values.size();
+            for (double value : values) out << " " << value;
+            out << '\n';
+        }
+    return true;
+}
+
+std::map<std::string, PerfSamples> read_perf_results(const std::string& path) {
+    std::map<std::string, PerfSamples> results;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string algorithm, benchmark, dims, metric;
+        size_t count = 0;
+        if (!(fields >> algorithm >> benchmark >> dims >> metric >> count)) continue;
+        std::vector<double>& values = results[algorithm + " " + benchmark + " " + dims][metric];
+        double value;
+        while (values.size() < count && fields >> value) values.push_back(value);
+    }
+    return results;
+}
+
+// Regularized incomplete beta function I_x(a, b), continued fraction (Numerical Recipes betacf)
+double incompleteBeta(double a, double b, double x) {
+    if (x <= 0.0) return 0.0;
+    if (x >= 1.0) return 1.0;
+    if (x > (a + 1.0) / (a + b + 2.0)) return 1.0 - incompleteBeta(b, a, 1.0 - x);
+
+    double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log(1.0 - x)) / a;
+    double c = 1.0, d = 1.0 - (a + b) * x / (a + 1.0);
+    if (std::abs(d) < 1e-300) d = 1e-300;
+    d = 1.0 / d;
+    double fraction = d;
+    for (int m = 1; m <= 200; ++m) {
+        for (int step = 0; step < 2; ++step) {
+            double numerator = step == 0 ? m * (b - m) * x / ((a + 2.0 * m - 1.0) * (a + 2.0 * m))
+                                         : -(a + m) * (a + b + m) * x / ((a + 2.0 * m) * (a + 2.0 * m + 1.0));
+            d = 1.0 + numerator * d;
+            if (std::abs(d) < 1e-300) d = 1e-300;
+            c = 1.0 + numerator / c;
+            if (std::abs(c) < 1e-300) c = 1e-300;
+            d = 1.0 / d;
+            fraction *= d * c;
+        }
+        if (std::abs(d * c - 1.0) < 1e-12) break;
+    }
+    return front * fraction;
+}
+
+// Two-sided p-value of Welch's t-test; 1 if there is not enough data
+double welch_p_value(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.size() < 2 || b.size() < 2) return 1.0;
+    auto moments = [](const std::vector<double>& values, double& mean, double& variance) {
+        mean = 0.0;
+        for (double value : values) mean += value;
+        mean /= values.size();
+        variance = 0.0;
+        for (double value : values) variance += (value - mean) * (value - mean);
+        variance /= values.size() - 1;
+    };
+    double mean_a, var_a, mean_b, var_b;
+    moments(a, mean_a, var_a);
+    moments(b, mean_b, var_b);
+    double se_a = var_a / a.size(), se_b = var_b / b.size();
+    if (se_a + se_b == 0.0) return mean_a == mean_b ? 1.0 : 0.0;
+
+    double t = (mean_a - mean_b) / std::sqrt(se_a + se_b);
+    double df = (se_a + se_b) * (se_a + se_b)
+                / (se_a * se_a / (a.size() - 1) + se_b * se_b / (b.size() - 1));
+    return incompleteBeta(df / 2.0, 0.5, df / (df + t * t));
+}
+
+// Prints every (job, metric) with a significant change; returns the number of regressions.
+// Significant: p < alpha and the medians differ by more than min_change (relative, see minimumChange).
+int compare_perf_results(const std::map<std::string, PerfSamples>& baseline, const std::map<std::string, PerfSamples>& current,
+                         double alpha = 0.01, double min_change = 0.03) {
+    auto median = [](std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        return values.empty() ? 0.0 : values[values.size() / 2];
+    };
+    int regressions = 0, improvements = 0, compared = 0;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& [key, samples] : current) {
+        auto old_job = baseline.find(key);
+        if (old_job == baseline.end()) continue;
+        for (const char* metric : perf_metrics) {
+            auto old_samples = old_job->second.find(metric);
+            auto new_samples = samples.find(metric);
+            if (old_samples == old_job->second.end() || new_samples == samples.end()) continue;
+            ++compared;
+            double old_median = median(old_samples->second), new_median = median(new_samples->second);
+            double change = old_median != 0.0 ? (new_median - old_median) / old_median : 0.0;
+            double p = welch_p_value(old_samples->second, new_samples->second);
+            if (p >= alpha || std::abs(change) <= minimumChange(metric, min_change)) continue;
+
+            bool worse = higherIsBetter(metric) ? change < 0.0 : change > 0.0;
+            (worse ? regressions : improvements)++;
+            std::cout << (worse ? "REGRESSION  " : "improvement ") << std::setw(14) << key << "  " << std::setw(16) << metric
+                      << std::setw(14) << old_median << " -> " << std::setw(14) << new_median << "  (" << std::showpos
+                      << change * 100.0 << std::noshowpos << "%, p = " << std::scientific << std::setprecision(1) << p
+                      << std::fixed << std::setprecision(2) << ")\n";
+        }
+    }
+    std::cout << compared << " comparisons, " << regressions << " regressions, " << improvements << " improvements" << std::endl;
+    return regressions;
+}
+
+// Versions of f5, f6, f12 and f13 before the raw-array kernels (std::pow, f12's y vector, u per
+// coordinate), kept as the reference of --check-kernels
+double reference_f5(const std::vector<double>& position) {
+    double result = 0.0;
+    for (size_t i = 0; i < position.size() - 1; ++i) {
+        double term1 = 100.0 * std::pow((position[i + 1] - position[i] * position[i]), 2);
+        double term2 = std::pow((position[i] - 1.0), 2);
+        result += term1 + term2;
+    }
+    return result;
+}
+
+double reference_f6(const std::vector<double>& position) {
+    return std::accumulate(position.begin(), position.end(), 0.0, [](double a, double b) { return a + std::pow(std::round(b + 0.5), 2); });
+}
+
+double reference_f12(const std::vector<double>& position) {
+    std::vector<double> y(position.size());
+    std::transform(position.begin(), position.end(), y.begin(), [](double xi) { return 1.0 + (xi + 1.0) / 4.0; });
+    double sum1 = std::accumulate(y.begin(), y.end() - 1, 0.0, [](double a, double b) { return a + std::pow(b - 1.0, 2.0) * (1.0 + 10.0 * std::sin(M_PI * b + 1.0) * std::sin(M_PI * b + 1.0)); });
+    double term1 = 10.0 * std::sin(M_PI * y[0]);
+    double term2 = std::pow(y.back() - 1.0, 2.0);
+    double sum2 = std::accumulate(position.begin(), position.end(), 0.0, [](double a, double b) { return a + u(b, 10.0, 100.0, 4.0); });
+    return M_PI / position.size() * (term1 + sum1 + term2) + sum2;
+}
+
+double reference_f13(const std::vector<double>& position) {
+    double sum1 = std::accumulate(position.begin(), position.end() - 1, 0.0, [](double a, double b) { return a + std::pow(b - 1.0, 2.0) * (1.0 + std::sin(3.0 * M_PI * b + 1.0) * std::sin(3.0 * M_PI * b + 1.0)); });
+    double term1 = 0.1 * std::sin(3.0 * M_PI * position[0]) * std::sin(3.0 * M_PI * position[0]);
+    double term2 = 0.1 * std::pow(position.back() - 1.0, 2.0) * (1.0 + std::sin(2.0 * M_PI * position.back()) * std::sin(2.0 * M_PI * position.back()));
+    double sum2 = std::accumulate(position.begin(), position.end(), 0.0, [](double a, double b) { return a + u(b, 5.0, 100.0, 4.0); });
+    return term1 + sum1 + term2 + sum2;
+}
+
+// Distance of two doubles in units in the last place (representable values between them)
+uint64_t ulpDistance(double a, double b) {
+    if (a == b) return 0;
+    if (std::isnan(a) || std::isnan(b)) return std::numeric_limits<uint64_t>::max();
+    auto ordered = [](double x) {
+        int64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return bits < 0 ? std::numeric_limits<int64_t>::min() - bits : bits;
+    };
+    int64_t ia = ordered(a), ib = ordered(b);
+    return ia > ib ? static_cast<uint64_t>(ia) - static_cast<uint64_t>(ib) : static_cast<uint64_t>(ib) - static_cast<uint64_t>(ia);
+}
+
+// The registry's function and batch kernel of f5, f6, f12 and f13 against the reference versions on
+// seeded random points, D = 1..100, in the default bounds and in a tenth of them (around the
+// penalty thresholds of f12/f13). f5 and f6 must be bit-identical; f12 and f13 sum the fourth
+// powers of the penalty in vector lanes and may differ by a few ULP. Returns the number of failures.
+int check_kernels() {
+    struct KernelCheck {
+        const char* benchmark;
+        double (*reference)(const std::vector<double>&);
+        uint64_t tolerance_ulp;
+    };
+    const KernelCheck checks[] = {{"f5", reference_f5, 0}, {"f6", reference_f6, 0}, {"f12", reference_f12, 16}, {"f13", reference_f13, 16}};
+    const int points_per_dimension = 400;
+    std::mt19937_64 generator(12345);
+    int failures = 0;
+    for (const KernelCheck& check : checks) {
+        const BenchmarkInfo* benchmark = find_benchmark(std::string(check.benchmark));
+        uint64_t worst = 0;
+        for (size_t dims = 1; dims <= 100; ++dims) {
+            for (double scale : {1.0, 0.1}) {
+                std::uniform_real_distribution<double> coordinate(benchmark->lower * scale, benchmark->upper * scale);
+                std::vector<double> population(points_per_dimension * dims), fitness(points_per_dimension);
+                for (double& x : population) x = coordinate(generator);
+                evaluate_population(*benchmark, population.data(), points_per_dimension, dims, fitness.data());
+                for (int p = 0; p < points_per_dimension; ++p) {
+                    std::vector<double> position(population.begin() + p * dims, population.begin() + (p + 1) * dims);
+                    double expected = check.reference(position);
+                    worst = std::max({worst, ulpDistance(benchmark->function(position), expected), ulpDistance(fitness[p], expected)});
+                }
+            }
+        }
+        bool ok = worst <= check.tolerance_ulp;
+        failures += !ok;
+        std::cout << check.benchmark << ": max " << worst << " ULP (tolerance " << check.tolerance_ulp << ") "
+                  << (ok ? "ok" : "FAILED") << std::endl;
+    }
+    return failures;
+}
+
+int main(int argc, char** argv) {
+    std::string out_path, baseline_path, compare_old, compare_new;
+    int repetitions = 7;
+    int cpu = -1;
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--check-kernels") return check_kernels() > 0 ? 2 : 0;
+        else if (option == "--out" && i + 1 < argc) out_path = argv[++i];
+        else if (option == "--baseline" && i + 1 < argc) baseline_path = argv[++i];
+        else if (option == "--reps" && i + 1 < argc) repetitions = std::stoi(argv[++i]);
+        else if (option == "--cpu" && i + 1 < argc) cpu = std::stoi(argv[++i]);
+        else if (option == "--compare" && i + 2 < argc) {
+            compare_old = argv[++i];
+            compare_new = argv[++i];
+        }
+    }
+
+    if (!compare_old.empty())
+        return compare_perf_results(read_perf_results(compare_old), read_perf_results(compare_new)) > 0 ? 2 : 0;
+    if (out_path.empty()) {
+        std::cerr << "Usage: perf_regression --out FILE [--reps N] [--cpu N] [--baseline OLD] | --compare OLD NEW | --check-kernels" << std::endl;
+        return 1;
+    }
+
+    // Default CPU: the last allowed one, usually the least busy with interrupts and the shell
+    if (cpu < 0) {
+        std::vector<CacheDomain> domains = read_topology();
+        cpu = domains.back().cpus.back();
+    }
+
+    // Repetitions interleaved over the jobs, so slow drifts (thermal, other load) hit every job alike
+    std::vector<PerfJob> jobs = perf_jobs();
+    std::map<std::string, PerfSamples> results;
+    for (int rep = 0; rep < repetitions; ++rep) {
+        for (const PerfJob& job : jobs) {
+            if (!measureRepetition(job, cpu, results[jobKey(job)])) {
+                std::cerr << "Job failed: " << jobKey(job) << std::endl;
+                return 1;
+            }
+        }
+        std::cerr << "\rrepetition " << rep + 1 << "/" << repetitions << std::flush;
+    }
+    std::cerr << std::endl;
+
+    if (!write_perf_results(out_path, results)) {
+        std::cerr << "Error opening " << out_path << " for writing" << std::endl;
+        return 1;
+    }
+    if (!baseline_path.empty())
+        return compare_perf_results(read_perf_results(baseline_path), results) > 0 ? 2 : 0;
+    return 0;
+}
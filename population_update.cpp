@@ -0,0 +1,156 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "random.cpp"
+#include "simd.cpp"
+
+// Population-wide position updates of WOA, SCA and AOA on contiguous N x D blocks.
+// The per-agent coefficients are drawn for the whole population first, in the order the scalar
+// ask/tell steps draw them, so the random streams stay the same. The inner loops then run over
+// plain arrays without branches (WOA's two branches are split into separate passes over the
+// agents of each branch), several coordinates at a time (simd.cpp). Every lane does the scalar
+// operations in the same order, so the candidates are bit-identical to the scalar steps.
+
+// Bounds of the search space as two arrays
+struct PopulationBounds {
+    std::vector<double> lower;
+    std::vector<double> upper;
+
+    explicit PopulationBounds(const std::vector<std::pair<double, double>>& search_space) {
+        for (const auto& bound : search_space) {
+            lower.push_back(bound.first);
+            upper.push_back(bound.second);
+        }
+    }
+
+    size_t dims() const { return lower.size(); }
+};
+
+inline void clampRow(double* row, const double* lower, const double* upper, size_t dims) {
+    size_t j = 0;
+    for (; j + simd_lanes <= dims; j += simd_lanes)
+        storeLanes(row + j, clampLanes(loadLanes(row + j), loadLanes(lower + j), loadLanes(upper + j)));
+    for (; j < dims; ++j)
+        row[j] = std::min(std::max(row[j], lower[j]), upper[j]);
+}
+
+// Per-agent coefficients drawn in bulk
+struct UpdateCoefficients {
+    std::vector<double> A, C, spiral_exp, spiral_cos;
+    std::vector<int> partner;
+    std::vector<int> encircling, spiral; // agents of each WOA branch
+
+    void resize(size_t num_agents) {
+        A.resize(num_agents);
+        C.resize(num_agents);
+        spiral_exp.resize(num_agents);
+        spiral_cos.resize(num_agents);
+        partner.resize(num_agents);
+    }
+};
+
+// WOA for all agents: candidates = update of agents with iteration coefficient a
+void woa_update_population(const double* agents, size_t num_agents, const PopulationBounds& bounds, double a,
+                           double* candidates, UpdateCoefficients& k) {
+    const size_t dims = bounds.dims();
+    const double b = 1;
+    k.resize(num_agents);
+    k.encircling.clear();
+    k.spiral.clear();
+    for (size_t i = 0; i < num_agents; ++i) {
+        double r1 = getRandomValue(0, 1);
+        double r2 = getRandomValue(0, 1);
+        k.A[i] = 2.0 * a * r1 - a;
+        k.C[i] = 2.0 * r2;
+        double l = (getRandomValue(0, 1) * 2) - 1;
+        double p = getRandomValue(0, 1);
+        k.partner[i] = static_cast<int>(getRandomValue(0, num_agents - 1));
+        k.spiral_exp[i] = std::exp(b * l);
+        k.spiral_cos[i] = std::cos(2 * M_PI * l);
+        (p < 0.5 ? k.encircling : k.spiral).push_back(static_cast<int>(i));
+    }
+
+    for (int i : k.encircling) {
+        const double* X_rand = agents + k.partner[i] * dims;
+        const double* X = agents + i * dims;
+        double* X_new = candidates + i * dims;
+        const double A = k.A[i], C = k.C[i];
+        const SimdDouble A_lanes = broadcastLanes(A), C_lanes = broadcastLanes(C);
+        size_t j = 0;
+        for (; j + simd_lanes <= dims; j += simd_lanes) {
+            SimdDouble r = loadLanes(X_rand + j);
+            storeLanes(X_new + j, r - A_lanes * absLanes(C_lanes * r - loadLanes(X + j)));
+        }
+        for (; j < dims; ++j)
+            X_new[j] = X_rand[j] - A * std::fabs(C * X_rand[j] - X[j]);
+        clampRow(X_new, bounds.lower.data(), bounds.upper.data(), dims);
+    }
+    for (int i : k.spiral) {
+        const double* X_rand = agents + k.partner[i] * dims;
+        const double* X = agents + i * dims;
+        double* X_new = candidates + i * dims;
+        const double e = k.spiral_exp[i], c = k.spiral_cos[i];
+        const SimdDouble e_lanes = broadcastLanes(e), c_lanes = broadcastLanes(c);
+        size_t j = 0;
+        for (; j + simd_lanes <= dims; j += simd_lanes) {
+            SimdDouble r = loadLanes(X_rand + j);
+            storeLanes(X_new + j, absLanes(r - loadLanes(X + j)) * e_lanes * c_lanes + r);
+        }
+        for (; j < dims; ++j)
+            X_new[j] = std::fabs(X_rand[j] - X[j]) * e * c + X_rand[j];
+        clampRow(X_new, bounds.lower.data(), bounds.upper.data(), dims);
+    }
+}
+
+// SCA for all agents (no clamping, as in sca())
+void sca_update_population(const double* agents, size_t num_agents, size_t dims, double a_t, double* candidates,
+                           UpdateCoefficients& k) {
+    k.resize(num_agents);
+    for (size_t i = 0; i < num_agents; ++i) {
+        double r1 = getRandomValue(0, 1);
+        double r2 = getRandomValue(0, 1);
+        k.A[i] = 2 * a_t * r1 - a_t;
+        k.C[i] = 2 * r2;
+        int random_agent_index = getRandomIndex(num_agents);
+        while (random_agent_index == static_cast<int>(i))
+            random_agent_index = getRandomIndex(num_agents);
+        k.partner[i] = random_agent_index;
+    }
+
+    for (size_t i = 0; i < num_agents; ++i) {
+        const double* random_agent = agents + k.partner[i] * dims;
+        const double* X = agents + i * dims;
+        double* new_position = candidates + i * dims;
+        const double AC = k.A[i] * k.C[i];
+        const SimdDouble AC_lanes = broadcastLanes(AC);
+        size_t j = 0;
+        for (; j + simd_lanes <= dims; j += simd_lanes) {
+            SimdDouble r = loadLanes(random_agent + j);
+            storeLanes(new_position + j, r + AC_lanes * (r - loadLanes(X + j)));
+        }
+        for (; j < dims; ++j)
+            new_position[j] = random_agent[j] + AC * (random_agent[j] - X[j]);
+    }
+}
+
+// AOA for all agents: the same shift for every agent, time_ratio = t / max_iter
+void aoa_update_population(const double* agents, size_t num_agents, const PopulationBounds& bounds, double time_ratio,
+                           double* candidates) {
+    const size_t dims = bounds.dims();
+    thread_local std::vector<double> shift;
+    shift.resize(dims);
+    for (size_t j = 0; j < dims; ++j)
+        shift[j] = (bounds.upper[j] - bounds.lower[j]) / 2.0 * std::sin(2 * M_PI * time_ratio);
+
+    for (size_t i = 0; i < num_agents; ++i) {
+        const double* X = agents + i * dims;
+        double* X_new = candidates + i * dims;
+        size_t j = 0;
+        for (; j + simd_lanes <= dims; j += simd_lanes)
+            storeLanes(X_new + j, loadLanes(X + j) + loadLanes(shift.data() + j));
+        for (; j < dims; ++j)
+            X_new[j] = X[j] + shift[j];
+        clampRow(X_new, bounds.lower.data(), bounds.upper.data(), dims);
+    }
+}
@@ -0,0 +1,288 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <cmath>
+#include "benchmarks.h"
+#include "random.cpp"
+#include "termination.cpp"
+#include "ask_tell.cpp"
+#include "topology.cpp"
+
+// Algorithm portfolio: the six optimizers (as ask/tell forms) work on one benchmark at the same
+// time under one budget of evaluations and seconds. Work is handed out in slices of a few
+// generations. Whenever a thread is free, a bandit controller picks the member it runs next:
+// the reward of a slice is 1 if it improved the portfolio's best and 0 otherwise, and the member
+// with the highest discounted mean reward plus an exploration bonus for members that had few
+// slices (UCB) goes next. Members that keep finding new bests get the threads and the
+// evaluations. A member steps on one thread at a time, but a thread whose best choice is busy
+// helps evaluating that member's current generation. The best position found so far is shared:
+// before a slice, a member that has not seen the current best takes it in place of its worst
+// agent. The iteration-dependent coefficients of every member follow the share of the common
+// budget spent so far, not the member's own evaluations. Each member keeps its own random
+// stream, so a single-threaded portfolio is reproducible.
+
+struct PortfolioMember {
+    std::string name;
+    std::function<std::unique_ptr<AskTellOptimizer>()> make;
+};
+
+struct PortfolioMemberStats {
+    std::string name;
+    long long slices = 0;
+    long long evaluations = 0;
+    double best_fitness = std::numeric_limits<double>::infinity();
+};
+
+struct PortfolioResult {
+    std::vector<double> best_solution;
+    double best_fitness;
+    long long evaluations;
+    double seconds;
+    std::vector<PortfolioMemberStats> members;
+    // (seconds, best fitness) at every improvement of the portfolio's best
+    std::vector<std::pair<double, double>> best_over_time;
+};
+
+struct PortfolioSettings {
+    long long max_evaluations = 300000;
+    double max_seconds = 0.0;     // 0: no time limit
+    int num_threads = 1;
+    int slice_generations = 5;    // generations per slice
+    double exploration = 0.2;     // weight of the UCB bonus
+    double reward_decay = 0.3;    // weight of the newest slice in the member's mean reward
+    uint64_t seed = 1;
+    double target = -std::numeric_limits<double>::infinity();
+};
+
+// The six optimizers with num_agents agents; max_iter spans the whole budget
+std::vector<PortfolioMember> default_portfolio(int num_agents, long long max_evaluations,
+                                               const std::vector<std::pair<double, double>>& search_space) {
+    int max_iter = static_cast<int>(std::max<long long>(1, max_evaluations / num_agents));
+    return {
+        {"WOA", [=]() { return std::unique_ptr<AskTellOptimizer>(new WoaAskTell(num_agents, max_iter, search_space)); }},
+        {"AOA", [=]() { return std::unique_ptr<AskTellOptimizer>(new AoaAskTell(num_agents, max_iter, search_space)); }},
+        {"SSA", [=]() { return std::unique_ptr<AskTellOptimizer>(new SsaAskTell(num_agents, max_iter, search_space)); }},
+        {"ICA", [=]() { return std::unique_ptr<AskTellOptimizer>(new IcaAskTell(num_agents, max_iter, search_space, 10)); }},
+        {"TLBO", [=]() { return std::unique_ptr<AskTellOptimizer>(new TlboAskTell(num_agents, max_iter, search_space)); }},
+        {"SCA", [=]() { return std::unique_ptr<AskTellOptimizer>(new ScaAskTell(num_agents, max_iter, search_space)); }},
+    };
+}
+
+class Portfolio {
+public:
+    Portfolio(const std::vector<PortfolioMember>& members, const Objective& benchmark_function, PortfolioSettings settings)
+        : benchmark_function(benchmark_function), settings(settings) {
+        for (size_t m = 0; m < members.size(); ++m) {
+            Arm arm;
+            arm.optimizer = members[m].make();
+            arm.random.seed(splitmix64(settings.seed + m));
+            arm.stats.name = members[m].name;
+            arm.finished = arm.optimizer->finished();
+            arms.push_back(std::move(arm));
+        }
+    }
+
+    PortfolioResult run() {
+        start_time = std::chrono::steady_clock::now();
+        int num_threads = std::max(1, std::min<int>(settings.num_threads, arms.size()));
+        if (num_threads == 1) {
+            work();
+        } else {
+            TopologyExecutor executor(num_threads);
+            for (int t = 0; t < num_threads; ++t) executor.submit(t, [this]() { work(); });
+            executor.wait();
+        }
+
+        PortfolioResult result{best_solution, best_fitness, evaluations, elapsed(), {}, best_over_time};
+        for (const Arm& arm : arms) result.members.push_back(arm.stats);
+        return result;
+    }
+
+private:
+    // Generation being evaluated; other threads may take candidates from it
+    struct SharedGeneration {
+        const std::vector<Candidate>* candidates;
+        size_t count;
+        std::vector<double> values;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+    };
+
+    struct Arm {
+        std::unique_ptr<AskTellOptimizer> optimizer;
+        std::shared_ptr<SharedGeneration> evaluating; // set while a generation is open to helpers
+        RandomEngine random;
+        PortfolioMemberStats stats;
+        double mean_reward = 0.0;
+        long long seen_version = 0; // version of the shared best the member has taken over
+        bool busy = false;
+        // optimizer->finished() as of the end of its last slice. Read under the lock instead of the
+        // optimizer, which the thread stepping a busy member changes without it.
+        bool finished = false;
+    };
+
+    double elapsed() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
+
+    // Under the lock: budget left and target not reached
+    bool running() const {
+        return !solved && evaluations < settings.max_evaluations &&
+               (settings.max_seconds <= 0.0 || elapsed() < settings.max_seconds);
+    }
+
+    // Under the lock: share of the budget spent
+    double progress() const {
+        double fraction = static_cast<double>(evaluations) / settings.max_evaluations;
+        if (settings.max_seconds > 0.0) fraction = std::max(fraction, elapsed() / settings.max_seconds);
+        return std::min(1.0, fraction);
+    }
+
+    // Under the lock: UCB score of a member; members that never ran come first
+    double score(const Arm& arm) const {
+        if (arm.stats.slices == 0) return std::numeric_limits<double>::infinity();
+        return arm.mean_reward + settings.exploration * std::sqrt(std::log(static_cast<double>(total_slices)) / arm.stats.slices);
+    }
+
+    // Under the lock: the member with the highest score, -1 if all are finished
+    int top(bool free_only) const {
+        int chosen = -1;
+        for (size_t m = 0; m < arms.size(); ++m) {
+            const Arm& arm = arms[m];
+            if ((free_only && arm.busy) || arm.finished) continue;
+            if (chosen < 0 || score(arm) > score(arms[chosen])) chosen = static_cast<int>(m);
+        }
+        return chosen;
+    }
+
+    // Loop of one thread: pick a member, run a slice, report back
+    void work() {
+        RandomEngine saved_random = random_engine;
+        RunControl saved_control = run_control;
+        std::vector<Candidate> generation;
+        run_control.target = settings.target;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (running()) {
+            int best_member = top(false);
+            if (best_member < 0) break;
+            if (arms[best_member].busy) {
+                if (std::shared_ptr<SharedGeneration> shared = arms[best_member].evaluating) {
+                    lock.unlock();
+                    evaluate(*shared);
+                    lock.lock();
+                    continue;
+                }
+            }
+            int m = top(true);
+            if (m < 0) {
+                member_free.wait(lock);
+                continue;
+            }
+            Arm& arm = arms[m];
+            arm.busy = true;
+            if (arm.seen_version != best_version) {
+                arm.optimizer->adopt(best_solution, best_fitness);
+                arm.seen_version = best_version;
+            }
+            double before = best_fitness;
+            arm.optimizer->setProgress(progress());
+            lock.unlock();
+
+            long long spent = slice(arm, generation);
+
+            lock.lock();
+            auto [position, value] = arm.optimizer->best();
+            arm.stats.slices++;
+            arm.stats.evaluations += spent;
+            arm.stats.best_fitness = value;
+            double reward = value < before ? 1.0 : 0.0;
+            arm.mean_reward = arm.stats.slices == 1 ? reward : (1.0 - settings.reward_decay) * arm.mean_reward + settings.reward_decay * reward;
+            ++total_slices;
+            evaluations += spent;
+            if (value < best_fitness) {
+                best_fitness = value;
+                best_solution = position;
+                ++best_version;
+                arm.seen_version = best_version;
+                best_over_time.push_back({elapsed(), value});
+            }
+            if (target_reached(value)) solved = true;
+            arm.finished = arm.optimizer->finished();
+            arm.busy = false;
+            member_free.notify_all();
+        }
+        member_free.notify_all();
+        lock.unlock();
+        random_engine = saved_random;
+        run_control = saved_control;
+    }
+
+    // Runs slice_generations generations of the member on this thread; returns the evaluations
+    long long slice(Arm& arm, std::vector<Candidate>& generation) {
+        random_engine = arm.random;
+        long long spent = 0;
+        for (int g = 0; g < settings.slice_generations && !arm.optimizer->finished(); ++g) {
+            size_t count = 0;
+            for (;; ++count) {
+                if (count == generation.size()) generation.emplace_back();
+                if (!arm.optimizer->ask(generation[count])) break;
+            }
+            // Open the generation to helpers, evaluate it, wait for candidates a helper still holds
+            auto shared = std::make_shared<SharedGeneration>();
+            shared->candidates = &generation;
+            shared->count = count;
+            shared->values.resize(count);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                arm.evaluating = shared;
+            }
+            evaluate(*shared);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                arm.evaluating.reset();
+            }
+            while (shared->done.load() < count) std::this_thread::yield();
+            for (size_t c = 0; c < count; ++c) arm.optimizer->tell(generation[c], shared->values[c]);
+            spent += count;
+        }
+        arm.random = random_engine;
+        return spent;
+    }
+
+    // Takes candidates of the generation until none is left
+    void evaluate(SharedGeneration& shared) {
+        for (size_t c; (c = shared.next.fetch_add(1)) < shared.count;) {
+            shared.values[c] = benchmark_function((*shared.candidates)[c].position);
+            shared.done.fetch_add(1);
+        }
+    }
+
+    Objective benchmark_function;
+    PortfolioSettings settings;
+    std::vector<Arm> arms;
+    std::mutex mutex;
+    std::condition_variable member_free;
+    std::chrono::steady_clock::time_point start_time;
+    long long evaluations = 0;
+    long long total_slices = 0;
+    bool solved = false;
+    std::vector<double> best_solution;
+    double best_fitness = std::numeric_limits<double>::infinity();
+    long long best_version = 0;
+    std::vector<std::pair<double, double>> best_over_time;
+};
+
+PortfolioResult run_portfolio(const std::vector<PortfolioMember>& members, const Objective& benchmark_function,
+                              const PortfolioSettings& settings) {
+    Portfolio portfolio(members, benchmark_function, settings);
+    return portfolio.run();
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include "noise.cpp"
+
+// Random numbers for the optimizers.
+// Each thread owns its engine, so parallel runs neither race on a shared generator nor
+// serialize on libc's rand() lock. A run is reproducible after seed_random(seed).
+
+// xoshiro256** (usable with the std distributions); the whole state is four words
+struct RandomEngine {
+    using result_type = uint64_t;
+    uint64_t state[4];
+
+    explicit RandomEngine(uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(uint64_t seed) {
+        for (uint64_t& s : state) s = seed = splitmix64(seed);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<uint64_t>::max(); }
+
+    result_type operator()() {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+inline thread_local RandomEngine random_engine;
+
+void seed_random(uint64_t seed) {
+    random_engine.seed(seed);
+}
+
+// Uniform value in [0, 1)
+double randomUnit() {
+    return static_cast<double>(random_engine() >> 11) * 0x1.0p-53;
+}
+
+double getRandomValue(double min, double max) {
+    return min + (max - min) * randomUnit();
+}
+
+// Uniform index in [0, max_index)
+int getRandomIndex(int max_index) {
+    return static_cast<int>(randomUnit() * max_index);
+}
@@ -0,0 +1,177 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <sstream>
+#include <limits>
+#include <stdexcept>
+#include <cmath>
+#include "benchmarks.h"
+
+// Registry of the benchmark functions: one entry per benchmark with its name, default bounds
+// and dimension, known optimum and capabilities. Runners select benchmarks from here instead
+// of keeping their own tables. Fast paths (batch, delta, noise model) are attached to the entry;
+// capabilities() reports them, and evaluate_population / evaluate_delta use them when present.
+
+enum BenchmarkCapability : unsigned {
+    CapBatch = 1 << 0,     // population kernel over a row-major buffer
+    CapSimd = 1 << 1,      // the batch kernel is vectorized
+    CapDelta = 1 << 2,     // value after changing one coordinate without a full evaluation
+    CapSeparable = 1 << 3, // sum of per-coordinate terms
+    CapNoisy = 1 << 4,     // value contains random noise (not cacheable)
+};
+
+using BatchFunction = void (*)(const double* population, size_t num_agents, size_t dims, double* fitness);
+// New value after position[j] changed from old_coordinate; value is the value before the change
+using DeltaFunction = double (*)(double value, const std::vector<double>& position, size_t j, double old_coordinate);
+
+struct BenchmarkInfo {
+    int id;            // number of the f-function, also the seed of its shift/rotation
+    const char* name;
+    double (*function)(const std::vector<double>&);
+    double lower, upper;
+    size_t dims;
+    // Optimum at the default bounds: optimum + optimum_per_dim * dims, NaN if not known
+    double optimum;
+    double optimum_per_dim;
+    unsigned tags; // declared properties (CapSeparable, CapSimd, CapNoisy)
+    BatchFunction batch;
+    DeltaFunction delta;
+    const NoisyBenchmark* noisy;
+
+    unsigned capabilities() const {
+        return tags | (batch ? CapBatch : 0u) | (delta ? CapDelta : 0u) | (noisy ? CapNoisy : 0u);
+    }
+
+    bool has(unsigned capability) const { return (capabilities() & capability) == capability; }
+
+    std::string label() const { return "f" + std::to_string(id); }
+
+    double optimumFor(size_t num_dimensions) const { return optimum + optimum_per_dim * num_dimensions; }
+
+    std::vector<std::pair<double, double>> searchSpace(size_t num_dimensions = 0) const {
+        return std::vector<std::pair<double, double>>(num_dimensions ? num_dimensions : dims, {lower, upper});
+    }
+};
+
+// Batch and delta kernels of the separable benchmarks, generated from their per-coordinate term
+template <double (*term)(double)>
+void separableBatch(const double* population, size_t num_agents, size_t dims, double* fitness) {
+    for (size_t a = 0; a < num_agents; ++a) {
+        const double* x = population + a * dims;
+        double sum = 0.0;
+        for (size_t j = 0; j < dims; ++j) sum += term(x[j]);
+        fitness[a] = sum;
+    }
+}
+
+template <double (*term)(double)>
+double separableDelta(double value, const std::vector<double>& position, size_t j, double old_coordinate) {
+    return value - term(old_coordinate) + term(position[j]);
+}
+
+// Batch kernel of a benchmark written on a raw row (benchmarks.cpp: rosenbrock_kernel, ...)
+template <double (*kernel)(const double*, size_t)>
+void rowBatch(const double* population, size_t num_agents, size_t dims, double* fitness) {
+    for (size_t a = 0; a < num_agents; ++a) fitness[a] = kernel(population + a * dims, dims);
+}
+
+inline double sphereTerm(double x) { return x * x; }
+inline double stepTerm(double x) {
+    double r = std::round(x + 0.5);
+    return r * r;
+}
+inline double schwefelTerm(double x) { return -x * std::sin(std::sqrt(std::abs(x))); }
+inline double rastriginTerm(double x) { return x * x - 10.0 * std::cos(2.0 * M_PI * x) + 10.0; }
+
+const std::vector<BenchmarkInfo>& benchmark_registry() {
+    const double unknown = std::numeric_limits<double>::quiet_NaN();
+    static const std::vector<BenchmarkInfo> registry = {
+        {1, "sphere", f1, -100, 100, 20, 0, 0, CapSeparable, separableBatch<sphereTerm>, separableDelta<sphereTerm>, nullptr},
+        {2, "schwefel_2_22", f2, -10, 10, 20, 0, 0, 0, nullptr, nullptr, nullptr},
+        {3, "schwefel_1_2", f3, -100, 100, 20, 0, 0, 0, nullptr, nullptr, nullptr},
+        {4, "max_abs", f4, -100, 100, 20, -100, 0, 0, nullptr, nullptr, nullptr}, // returns the signed coordinate
+        {5, "rosenbrock", f5, -30, 30, 20, 0, 0, 0, rowBatch<rosenbrock_kernel>, nullptr, nullptr},
+        {6, "step", f6, -10, 10, 20, 0, 0, CapSeparable, separableBatch<stepTerm>, separableDelta<stepTerm>, nullptr},
+        {7, "quartic_noise", f7, -1.28, 1.28, 20, 0, 0, CapSeparable, nullptr, nullptr, &f7_noisy},
+        {8, "schwefel_2_26", f8, -500, 500, 20, 0, -418.9828872724338, CapSeparable, separableBatch<schwefelTerm>, separableDelta<schwefelTerm>, nullptr},
+        {9, "rastrigin", f9, -5.12, 5.12, 20, 0, 0, CapSeparable, separableBatch<rastriginTerm>, separableDelta<rastriginTerm>, nullptr},
+        {10, "ackley", f10, -32, 32, 20, 0, 0, 0, nullptr, nullptr, nullptr},
+        {11, "griewank_sqrt", f11, -600, 600, 20, 1, -1, 0, nullptr, nullptr, nullptr}, // cos(sqrt|x|) variant
+        {12, "penalized_1", f12, -50, 50, 20, unknown, 0, CapSimd, rowBatch<penalized1_kernel>, nullptr, nullptr},
+        {13, "penalized_2", f13, -50, 50, 20, 0, 0, CapSimd, rowBatch<penalized2_kernel>, nullptr, nullptr},
+        {14, "composite_1", f14, -5, 5, 10, 0, 0, 0, nullptr, nullptr, nullptr},
+        {15, "composite_2", f15, -5, 5, 10, 0, 0, 0, nullptr, nullptr, nullptr},
+        {16, "composite_3", f16, -5, 5, 10, 0, 0, 0, nullptr, nullptr, nullptr},
+        {17, "composite_4", f17, -5, 5, 10, unknown, 0, CapNoisy, nullptr, nullptr, nullptr}, // contains f7
+        {18, "composite_5", f18, -5, 5, 10, 0.1, -0.1, 0, nullptr, nullptr, nullptr},
+        {19, "composite_6", f19, -5, 5, 10, 0.0305, -0.0305, 0, nullptr, nullptr, nullptr},
+    };
+    return registry;
+}
+
+// By number (1..19); nullptr if there is no such benchmark
+const BenchmarkInfo* find_benchmark(int id) {
+    for (const BenchmarkInfo& info : benchmark_registry())
+        if (info.id == id) return &info;
+    return nullptr;
+}
+
+// By name ("rastrigin") or label ("f9")
+const BenchmarkInfo* find_benchmark(const std::string& name) {
+    for (const BenchmarkInfo& info : benchmark_registry())
+        if (name == info.name || name == info.label()) return &info;
+    return nullptr;
+}
+
+unsigned capabilityFromName(const std::string& tag) {
+    if (tag == "batch") return CapBatch;
+    if (tag == "simd") return CapSimd;
+    if (tag == "delta") return CapDelta;
+    if (tag == "separable") return CapSeparable;
+    if (tag == "noisy") return CapNoisy;
+    return 0;
+}
+
+// Comma-separated names, labels or tags, in registry order: "all", "f1,f9", "separable",
+// "batch,f10". A leading '!' excludes ("all,!noisy"). Unknown entries throw.
+std::vector<const BenchmarkInfo*> select_benchmarks(const std::string& spec) {
+    std::vector<bool> selected(benchmark_registry().size(), false);
+    std::stringstream stream(spec.empty() ? "all" : spec);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        bool exclude = !item.empty() && item[0] == '!';
+        if (exclude) item.erase(0, 1);
+        const BenchmarkInfo* named = find_benchmark(item);
+        unsigned capability = capabilityFromName(item);
+        if (item != "all" && !named && !capability)
+            throw std::invalid_argument("unknown benchmark or tag: " + item);
+        for (size_t b = 0; b < selected.size(); ++b) {
+            const BenchmarkInfo& info = benchmark_registry()[b];
+            if (item == "all" || &info == named || (capability && info.has(capability)))
+                selected[b] = !exclude;
+        }
+    }
+    std::vector<const BenchmarkInfo*> benchmarks;
+    for (size_t b = 0; b < selected.size(); ++b)
+        if (selected[b]) benchmarks.push_back(&benchmark_registry()[b]);
+    return benchmarks;
+}
+
+// Row-major population through the batch kernel if there is one, point by point otherwise
+void evaluate_population(const BenchmarkInfo& info, const double* population, size_t num_agents, size_t dims,
+                         double* fitness) {
+    if (info.batch) {
+        info.batch(population, num_agents, dims, fitness);
+        return;
+    }
+    std::vector<double> position(dims);
+    for (size_t a = 0; a < num_agents; ++a) {
+        position.assign(population + a * dims, population + (a + 1) * dims);
+        fitness[a] = info.function(position);
+    }
+}
+
+double evaluate_delta(const BenchmarkInfo& info, double value, const std::vector<double>& position, size_t j,
+                      double old_coordinate) {
+    return info.delta ? info.delta(value, position, j, old_coordinate) : info.function(position);
+}
@@ -0,0 +1,318 @@
+#pragma once
+#include <vector>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include "benchmarks.h"
+#include "registry.cpp"
+
+// Shifted and rotated variants of f1..f19: F(x) = f(M (x - o)).
+// M is a random orthogonal matrix and o a random shift; both are generated once per
+// (function, dimension), kept in memory for the rest of the process and reused by every run.
+
+struct ShiftRotation {
+    size_t dims;
+    std::vector<double> shift;  // o, inside 80% of the search range
+    std::vector<double> matrix; // M, dims x dims, row-major
+};
+
+// Random orthogonal matrix: Gram-Schmidt over Gaussian rows
+std::vector<double> randomRotation(size_t dims, std::mt19937_64& generator) {
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::vector<double> m(dims * dims);
+    for (double& v : m) v = normal(generator);
+
+    for (size_t i = 0; i < dims; ++i) {
+        double* row = &m[i * dims];
+        for (size_t k = 0; k < i; ++k) {
+            const double* prev = &m[k * dims];
+            double dot = 0.0;
+            for (size_t j = 0; j < dims; ++j) dot += row[j] * prev[j];
+            for (size_t j = 0; j < dims; ++j) row[j] -= dot * prev[j];
+        }
+        double norm = 0.0;
+        for (size_t j = 0; j < dims; ++j) norm += row[j] * row[j];
+        norm = std::sqrt(norm);
+        for (size_t j = 0; j < dims; ++j) row[j] /= norm;
+    }
+    return m;
+}
+
+// Transform of the given function and dimension, created on first use.
+// `bound` is the half-width of the search range used to place the shift.
+const ShiftRotation& shift_rotation_for(int function_id, size_t dims, double bound) {
+    static std::mutex mutex;
+    static std::map<std::pair<int, size_t>, std::unique_ptr<ShiftRotation>> transforms;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& entry = transforms[{function_id, dims}];
+    if (!entry) {
+        std::mt19937_64 generator(static_cast<uint64_t>(function_id) * 1000003ULL + dims);
+        std::uniform_real_distribution<double> uniform(-0.8 * bound, 0.8 * bound);
+        entry.reset(new ShiftRotation{dims, std::vector<double>(dims), {}});
+        for (double& o : entry->shift) o = uniform(generator);
+        entry->matrix = randomRotation(dims, generator);
+    }
+    return *entry;
+}
+
+// z = M (x - o). Four rows of M share each load of (x - o), and the columns are walked in
+// blocks so the active part of (x - o) stays in L1 at large D.
+void rotate(const ShiftRotation& transform, const double* x, double* z) {
+    const size_t n = transform.dims;
+    const size_t column_block = 512;
+    const double* m = transform.matrix.data();
+
+    thread_local std::vector<double> y;
+    y.resize(n);
+    for (size_t j = 0; j < n; ++j) y[j] = x[j] - transform.shift[j];
+    std::fill(z, z + n, 0.0);
+
+    for (size_t jb = 0; jb < n; jb += column_block) {
+        size_t je = std::min(n, jb + column_block);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const double* m0 = m + i * n;
+            const double* m1 = m0 + n;
+            const double* m2 = m1 + n;
+            const double* m3 = m2 + n;
+            double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+            for (size_t j = jb; j < je; ++j) {
+                s0 += m0[j] * y[j];
+                s1 += m1[j] * y[j];
+                s2 += m2[j] * y[j];
+                s3 += m3[j] * y[j];
+            }
+            z[i] += s0;
+            z[i + 1] += s1;
+            z[i + 2] += s2;
+            z[i + 3] += s3;
+        }
+        for (; i < n; ++i) {
+            const double* mi = m + i * n;
+            double s = 0.0;
+            for (size_t j = jb; j < je; ++j) s += mi[j] * y[j];
+            z[i] += s;
+        }
+    }
+}
+
+// Whole population at once: Z = (X - o) M^T for a row-major num_agents x dims block.
+// Tiled so a tile of M is reused by every agent of a tile of the population.
+void rotate_population(const ShiftRotation& transform, const double* population, size_t num_agents, double* rotated) {
+    const size_t n = transform.dims;
+    const size_t agent_block = 32, row_block = 64, column_block = 256;
+    const double* m = transform.matrix.data();
+
+    std::vector<double> y(num_agents * n);
+    for (size_t a = 0; a < num_agents; ++a)
+        for (size_t j = 0; j < n; ++j)
+            y[a * n + j] = population[a * n + j] - transform.shift[j];
+    std::fill(rotated, rotated + num_agents * n, 0.0);
+
+    for (size_t ab = 0; ab < num_agents; ab += agent_block) {
+        size_t ae = std::min(num_agents, ab + agent_block);
+        for (size_t ib = 0; ib < n; ib += row_block) {
+            size_t ie = std::min(n, ib + row_block);
+            for (size_t jb = 0; jb < n; jb += column_block) {
+                size_t je = std::min(n, jb + column_block);
+                size_t a = ab;
+                // 2 agents x 4 rows of M per pass: 8 independent accumulators
+                for (; a + 2 <= ae; a += 2) {
+                    const double* y0 = &y[a * n];
+                    const double* y1 = y0 + n;
+                    double* z0 = rotated + a * n;
+                    double* z1 = z0 + n;
+                    size_t i = ib;
+                    for (; i + 4 <= ie; i += 4) {
+                        const double* m0 = m + i * n;
+                        const double* m1 = m0 + n;
+                        const double* m2 = m1 + n;
+                        const double* m3 = m2 + n;
+                        double s00 = 0.0, s01 = 0.0, s02 = 0.0, s03 = 0.0;
+                        double s10 = 0.0, s11 = 0.0, s12 = 0.0, s13 = 0.0;
+                        for (size_t j = jb; j < je; ++j) {
+                            s00 += m0[j] * y0[j]; s01 += m1[j] * y0[j]; s02 += m2[j] * y0[j]; s03 += m3[j] * y0[j];
+                            s10 += m0[j] * y1[j]; s11 += m1[j] * y1[j]; s12 += m2[j] * y1[j]; s13 += m3[j] * y1[j];
+                        }
+                        z0[i] += s00; z0[i + 1] += s01; z0[i + 2] += s02; z0[i + 3] += s03;
+                        z1[i] += s10; z1[i + 1] += s11; z1[i + 2] += s12; z1[i + 3] += s13;
+                    }
+                    for (; i < ie; ++i) {
+                        const double* mi = m + i * n;
+                        double s0 = 0.0, s1 = 0.0;
+                        for (size_t j = jb; j < je; ++j) {
+                            s0 += mi[j] * y0[j];
+                            s1 += mi[j] * y1[j];
+                        }
+                        z0[i] += s0;
+                        z1[i] += s1;
+                    }
+                }
+                for (; a < ae; ++a) {
+                    const double* ya = &y[a * n];
+                    double* za = rotated + a * n;
+                    for (size_t i = ib; i < ie; ++i) {
+                        const double* mi = m + i * n;
+                        double s = 0.0;
+                        for (size_t j = jb; j < je; ++j) s += mi[j] * ya[j];
+                        za[i] += s;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Components of the composites f14..f19, same functions, lambdas and biases as in benchmarks.cpp
+struct CompositeSpec {
+    double (*functions[10])(const std::vector<double>&);
+    double lambdas[10];
+    double biases[10];
+};
+
+const CompositeSpec composite_specs[6] = {
+    {{f1, f1, f1, f1, f1, f1, f1, f1, f1, f1},
+     {5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0},
+     {1, 1, 1, 1, 1, 1, 1, 1, 1, 1}},
+    {{f2, f2, f2, f2, f2, f2, f2, f2, f2, f2},
+     {5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0},
+     {1, 1, 1, 1, 1, 1, 1, 1, 1, 1}},
+    {{f3, f3, f3, f3, f3, f3, f3, f3, f3, f3},
+     {1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
+     {1, 1, 1, 1, 1, 1, 1, 1, 1, 1}},
+    {{f10, f10, f9, f9, f8, f8, f7, f7, f1, f1},
+     {5.0/32.0, 5.0/32.0, 1.0, 1.0, 5.0/0.5, 5.0/0.5, 5.0/100.0, 5.0/100.0, 5.0/100.0, 5.0/100.0},
+     {1, 1, 1, 1, 1, 1, 1, 1, 1, 1}},
+    {{f9, f9, f2, f2, f11, f11, f10, f10, f1, f1},
+     {1/5.0, 1/5.0, 5/0.5, 5/0.5, 5/100.0, 5/100.0, 5/32.0, 5/32.0, 5/100.0, 5/100.0},
+     {1, 1, 1, 1, 1, 1, 1, 1, 1, 1}},
+    {{f9, f9, f2, f2, f11, f11, f10, f10, f1, f1},
+     {0.1 * 1/5.0, 0.2 * 1/5.0, 0.3 * 5/0.5, 0.4 * 5/0.5, 0.5 * 5/100.0, 0.6 * 5/100.0, 0.7 * 5/32.0, 0.8 * 5/32.0, 0.9 * 5/100.0, 1 * 5/100.0},
+     {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1}},
+};
+
+using CompositeTransforms = std::array<const ShiftRotation*, 10>;
+
+CompositeTransforms compositeTransforms(int function_id, size_t dims, double bound) {
+    CompositeTransforms transforms;
+    for (int c = 0; c < 10; ++c) transforms[c] = &shift_rotation_for(function_id * 100 + c, dims, bound);
+    return transforms;
+}
+
+// Distance weight of a component whose optimum lies distance2 away (squared); sigma = 1 for all
+inline double compositeWeight(double distance2, size_t dims) {
+    const double sigma = 1.0;
+    return distance2 == 0.0 ? std::numeric_limits<double>::infinity()
+                            : std::exp(-distance2 / (2.0 * dims * sigma * sigma)) / std::sqrt(distance2);
+}
+
+// Weighted sum of the component values; an exact hit on an optimum takes the whole weight
+double combineComponents(const double* values, const double* weights) {
+    double max_weight = 0.0;
+    for (int c = 0; c < 10; ++c) max_weight = std::max(max_weight, weights[c]);
+    double result = 0.0, weight_sum = 0.0;
+    for (int c = 0; c < 10; ++c) {
+        double w = std::isinf(max_weight) ? (std::isinf(weights[c]) ? 1.0 : 0.0) : weights[c];
+        weight_sum += w;
+        result += w * values[c];
+    }
+    return weight_sum == 0.0 ? result : result / weight_sum;
+}
+
+double squaredDistance(const double* x, const std::vector<double>& o) {
+    double distance2 = 0.0;
+    for (size_t j = 0; j < o.size(); ++j) {
+        double d = x[j] - o[j];
+        distance2 += d * d;
+    }
+    return distance2;
+}
+
+// CEC-style composition: every component has its own optimum o_i and rotation M_i,
+// and is weighted by the distance of x to o_i
+double compositeShiftRotated(const CompositeSpec& spec, const CompositeTransforms& transforms, const std::vector<double>& position) {
+    const size_t dims = position.size();
+    double values[10], weights[10];
+    thread_local std::vector<double> z;
+    z.resize(dims);
+    for (int c = 0; c < 10; ++c) {
+        const ShiftRotation& transform = *transforms[c];
+        weights[c] = compositeWeight(squaredDistance(position.data(), transform.shift), dims);
+        rotate(transform, position.data(), z.data());
+        values[c] = spec.lambdas[c] * spec.functions[c](z) + spec.biases[c];
+    }
+    return combineComponents(values, weights);
+}
+
+// Registry entry of a component function, for its batch kernel
+const BenchmarkInfo& componentBenchmark(double (*function)(const std::vector<double>&)) {
+    for (const BenchmarkInfo& info : benchmark_registry())
+        if (info.function == function) return info;
+    throw std::logic_error("composite component is not in the registry");
+}
+
+// The composition over a row-major population: per component, one rotate_population product and
+// one call of the component's batch kernel. Same values as compositeShiftRotated point by point
+// (f17: its f7 components draw their noise component by component instead of point by point).
+void compositeShiftRotatedPopulation(const CompositeSpec& spec, const CompositeTransforms& transforms, const double* population,
+                                     size_t num_agents, size_t dims, double* fitness) {
+    thread_local std::vector<double> rotated, values, weights;
+    rotated.resize(num_agents * dims);
+    values.resize(num_agents * 10);
+    weights.resize(num_agents * 10);
+    for (int c = 0; c < 10; ++c) {
+        const ShiftRotation& transform = *transforms[c];
+        rotate_population(transform, population, num_agents, rotated.data());
+        evaluate_population(componentBenchmark(spec.functions[c]), rotated.data(), num_agents, dims, fitness);
+        for (size_t a = 0; a < num_agents; ++a) {
+            values[a * 10 + c] = spec.lambdas[c] * fitness[a] + spec.biases[c];
+            weights[a * 10 + c] = compositeWeight(squaredDistance(population + a * dims, transform.shift), dims);
+        }
+    }
+    for (size_t a = 0; a < num_agents; ++a) fitness[a] = combineComponents(&values[a * 10], &weights[a * 10]);
+}
+
+// Shifted and rotated version of benchmark f<function_id> in the given dimension
+Objective shift_rotated(int function_id, size_t dims, double bound) {
+    if (function_id >= 14) {
+        const CompositeSpec& spec = composite_specs[function_id - 14];
+        CompositeTransforms transforms = compositeTransforms(function_id, dims, bound);
+        return [&spec, transforms](const std::vector<double>& position) {
+            return compositeShiftRotated(spec, transforms, position);
+        };
+    }
+
+    const ShiftRotation& transform = shift_rotation_for(function_id, dims, bound);
+    double (*benchmark_function)(const std::vector<double>&) = find_benchmark(function_id)->function;
+    return [&transform, benchmark_function](const std::vector<double>& position) {
+        thread_local std::vector<double> z;
+        z.resize(transform.dims);
+        rotate(transform, position.data(), z.data());
+        return benchmark_function(z);
+    };
+}
+
+// Batch evaluation of a row-major population through one blocked matrix-matrix product (one per
+// component for the composites)
+void evaluate_population_shift_rotated(int function_id, const std::vector<double>& population, size_t num_agents,
+                                       size_t dims, double bound, std::vector<double>& fitness) {
+    fitness.resize(num_agents);
+    if (function_id >= 14) {
+        compositeShiftRotatedPopulation(composite_specs[function_id - 14], compositeTransforms(function_id, dims, bound),
+                                        population.data(), num_agents, dims, fitness.data());
+        return;
+    }
+
+    const ShiftRotation& transform = shift_rotation_for(function_id, dims, bound);
+    std::vector<double> rotated(num_agents * dims);
+    rotate_population(transform, population.data(), num_agents, rotated.data());
+
+    evaluate_population(*find_benchmark(function_id), rotated.data(), num_agents, dims, fitness.data());
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Lanes of doubles with GCC/Clang vector types: SSE2 pairs by default, four lanes with -mavx.
+// Operations on lanes are the scalar IEEE operations done per lane, so a kernel written with
+// them gives the same bits as its scalar loop as long as it keeps the order of operations.
+
+#ifdef __AVX__
+constexpr size_t simd_lanes = 4;
+#else
+constexpr size_t simd_lanes = 2;
+#endif
+typedef double SimdDouble __attribute__((vector_size(simd_lanes * sizeof(double))));
+typedef uint64_t SimdBits __attribute__((vector_size(simd_lanes * sizeof(double))));
+
+inline SimdDouble loadLanes(const double* p) {
+    SimdDouble v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void storeLanes(double* p, SimdDouble v) { std::memcpy(p, &v, sizeof(v)); }
+
+inline SimdDouble broadcastLanes(double x) { return SimdDouble{} + x; }
+
+// std::fabs per lane: clears the sign bit
+inline SimdDouble absLanes(SimdDouble v) {
+    return (SimdDouble)((SimdBits)v & static_cast<uint64_t>(0x7FFFFFFFFFFFFFFFULL));
+}
+
+// std::min(std::max(v, lower), upper) per lane, same NaN behaviour
+inline SimdDouble clampLanes(SimdDouble v, SimdDouble lower, SimdDouble upper) {
+    v = v < lower ? lower : v;
+    return upper < v ? upper : v;
+}
+
+// Sum of the lanes, lane 0 first
+inline double sumLanes(SimdDouble v) {
+    double sum = 0.0;
+    for (size_t lane = 0; lane < simd_lanes; ++lane) sum += v[lane];
+    return sum;
+}
@@ -0,0 +1,233 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <type_traits>
+#include <unistd.h>
+#include "random.cpp"
+#include "noise.cpp"
+#include "termination.cpp"
+
+// Snapshots of a running optimizer, for long runs on machines that can be preempted.
+// At the start of every interval-th iteration the optimizer serializes its population and the
+// other state it carries between iterations; the thread's random engine, run control (target,
+// evaluation counts) and noise context are added to it. The bytes are handed to a writer thread,
+// which writes them to <path>.tmp and renames that over <path>, so the main loop only pays for
+// the copy and the file is always a complete snapshot. A run started with a snapshot on disk
+// continues from its iteration with the same random stream, so it follows the trajectory it
+// would have followed without the interruption.
+
+// A snapshot file that cannot be restored: another format or algorithm, or cut short. The state it
+// was read into is then partly overwritten, so the caller starts the run over.
+struct SnapshotError : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+// Serialized state: written in save mode, read back in the same order in load mode
+class SnapshotArchive {
+public:
+    SnapshotArchive() = default; // save mode
+    explicit SnapshotArchive(std::vector<char> data) : bytes(std::move(data)), load(true) {}
+
+    bool loading() const { return load; }
+    const std::vector<char>& data() const { return bytes; }
+
+    template <typename T>
+    void field(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot fields are plain values or vectors");
+        raw(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void field(std::vector<T>& values) {
+        uint64_t size = values.size();
+        field(size);
+        if (load) {
+            // Every element takes at least its size (plain values) or its own size field (vectors, strings)
+            checkCount(size, std::is_trivially_copyable<T>::value ? sizeof(T) : sizeof(uint64_t));
+            values.resize(size);
+        }
+        for (T& value : values) field(value);
+    }
+
+    void field(std::string& text) {
+        uint64_t size = text.size();
+        field(size);
+        if (load) {
+            checkCount(size, 1);
+            text.resize(size);
+        }
+        raw(&text[0], size);
+    }
+
+private:
+    // A corrupt size field must not allocate more than the rest of the snapshot could hold
+    void checkCount(uint64_t count, size_t element_bytes) const {
+        if (count > (bytes.size() - position) / element_bytes) throw SnapshotError("snapshot is truncated");
+    }
+
+    void raw(void* data, size_t size) {
+        if (!load) {
+            const char* begin = static_cast<const char*>(data);
+            bytes.insert(bytes.end(), begin, begin + size);
+            return;
+        }
+        if (position + size > bytes.size()) throw SnapshotError("snapshot is truncated");
+        std::memcpy(data, bytes.data() + position, size);
+        position += size;
+    }
+
+    std::vector<char> bytes;
+    size_t position = 0;
+    bool load = false;
+};
+
+class RunSnapshots {
+public:
+    // Snapshot every interval iterations to path
+    RunSnapshots(std::string path, int interval) : path(std::move(path)), interval(interval) {
+        writer = std::thread([this]() { writeLoop(); });
+    }
+
+    ~RunSnapshots() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        work_available.notify_all();
+        writer.join();
+    }
+
+    // Restores the state of a run of algorithm from the snapshot file; false if there is none.
+    // state(archive) lists the optimizer's fields, as for checkpoint().
+    template <typename State>
+    bool restore(const std::string& algorithm, int& iteration, const State& state) {
+        std::vector<char> data;
+        if (!readFile(path, data)) return false;
+        SnapshotArchive archive(std::move(data));
+        uint64_t magic = 0;
+        std::string saved_algorithm;
+        if (archive.data().size() >= sizeof(magic)) archive.field(magic);
+        if (magic != snapshot_magic) throw SnapshotError(path + " is not a snapshot of this format");
+        archive.field(saved_algorithm);
+        if (saved_algorithm != algorithm) throw SnapshotError(path + " is not a snapshot of " + algorithm);
+        archive.field(iteration);
+        runState(archive);
+        state(archive);
+        return true;
+    }
+
+    // Called at the start of every iteration; hands a snapshot to the writer every interval iterations
+    template <typename State>
+    void checkpoint(const std::string& algorithm, int iteration, const State& state) {
+        if (interval <= 0 || iteration == 0 || iteration % interval != 0) return;
+        SnapshotArchive archive;
+        uint64_t magic = snapshot_magic;
+        std::string name = algorithm;
+        archive.field(magic);
+        archive.field(name);
+        archive.field(iteration);
+        runState(archive);
+        state(archive);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = archive.data(); // a snapshot the writer has not reached yet is replaced
+            has_pending = true;
+        }
+        work_available.notify_one();
+    }
+
+    // Waits until the last snapshot is on disk
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        written.wait(lock, [this]() { return !has_pending && !writing; });
+    }
+
+    // The run is complete: waits for the writer and removes the file
+    void discard() {
+        flush();
+        std::remove(path.c_str());
+    }
+
+    long long snapshotsWritten() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return snapshots_written;
+    }
+
+private:
+    static constexpr uint64_t snapshot_magic = 0x32504E534852454DULL; // format 2: WOA/SCA carry their restart epoch
+
+    // The per-thread state every optimizer shares
+    static void runState(SnapshotArchive& archive) {
+        archive.field(random_engine.state);
+        archive.field(run_control);
+        archive.field(noise_context);
+    }
+
+    static bool readFile(const std::string& file_path, std::vector<char>& data) {
+        FILE* file = std::fopen(file_path.c_str(), "rb");
+        if (!file) return false;
+        char buffer[1 << 16];
+        size_t count;
+        while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) data.insert(data.end(), buffer, buffer + count);
+        std::fclose(file);
+        return true;
+    }
+
+    void writeLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            work_available.wait(lock, [this]() { return has_pending || stopping; });
+            if (!has_pending) return;
+            std::vector<char> data;
+            data.swap(pending);
+            has_pending = false;
+            writing = true;
+            lock.unlock();
+
+            std::string temporary = path + ".tmp";
+            FILE* file = std::fopen(temporary.c_str(), "wb");
+            bool ok = file && std::fwrite(data.data(), 1, data.size(), file) == data.size();
+            if (file) {
+                ok = std::fflush(file) == 0 && fsync(fileno(file)) == 0 && ok;
+                ok = std::fclose(file) == 0 && ok;
+            }
+            if (ok) ok = std::rename(temporary.c_str(), path.c_str()) == 0;
+            if (!ok) std::fprintf(stderr, "snapshot: cannot write %s\n", path.c_str());
+
+            lock.lock();
+            writing = false;
+            if (ok) ++snapshots_written;
+            written.notify_all();
+        }
+    }
+
+    std::string path;
+    int interval;
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable written;
+    std::vector<char> pending;
+    bool has_pending = false;
+    bool writing = false;
+    bool stopping = false;
+    long long snapshots_written = 0;
+};
+
+// The optimizers call these with their optional RunSnapshots (nullptr: no snapshots)
+template <typename State>
+bool restore_snapshot(RunSnapshots* snapshots, const std::string& algorithm, int& iteration, const State& state) {
+    return snapshots && snapshots->restore(algorithm, iteration, state);
+}
+
+template <typename State>
+void checkpoint_snapshot(RunSnapshots* snapshots, const std::string& algorithm, int iteration, const State& state) {
+    if (snapshots) snapshots->checkpoint(algorithm, iteration, state);
+}
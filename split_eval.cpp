@@ -0,0 +1,182 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <mutex>
+#include <condition_variable>
+#include <cmath>
+#include "benchmarks.h"
+#include "topology.cpp"
+
+// One evaluation split across threads, for very large dimensions (D around 10^5 and above).
+// The benchmarks below are built from sums of per-coordinate terms. The coordinates are cut into
+// chunks of a fixed size, every chunk is summed on its own (chunks are shared out over a pool),
+// and the partial sums are added in chunk order. The order of the additions therefore depends
+// only on D and the chunk size, never on the number of threads: the value is the same with 1 or
+// 64 threads. Up to one chunk it is the plain f-function's value; above, it differs from it
+// (which sums left to right) by rounding only.
+// Composites evaluate each of their sums once and combine them as the f-functions do.
+
+const size_t split_eval_chunk = 8192;       // coordinates per chunk
+const size_t split_eval_threshold = 100000; // D from which split_objective splits evaluations
+
+class SplitReducer {
+public:
+    // num_threads = 0: one per allowed CPU; the calling thread works on a share as well
+    explicit SplitReducer(size_t num_threads = 0, size_t chunk = split_eval_chunk)
+        : executor(num_threads), chunk(chunk) {}
+
+    size_t threadCount() const { return executor.threadCount(); }
+
+    // K sums over x[0..n): term(x[i], acc) adds the terms of coordinate i to acc[0..K)
+    template <size_t K, typename Term>
+    std::array<double, K> sums(const double* x, size_t n, const Term& term) {
+        size_t num_chunks = (n + chunk - 1) / chunk;
+        std::vector<std::array<double, K>> partial(num_chunks);
+        auto sumChunks = [&](size_t first, size_t step) {
+            for (size_t c = first; c < num_chunks; c += step) {
+                std::array<double, K> acc{};
+                for (size_t i = c * chunk; i < std::min(n, (c + 1) * chunk); ++i) term(x[i], acc);
+                partial[c] = acc;
+            }
+        };
+
+        size_t shares = std::min(num_chunks, threadCount() + 1);
+        if (shares > 1) {
+            Latch latch(shares - 1);
+            for (size_t s = 1; s < shares; ++s)
+                executor.submit(s, [&, s]() {
+                    sumChunks(s, shares);
+                    latch.countDown();
+                });
+            sumChunks(0, shares);
+            latch.wait();
+        } else {
+            sumChunks(0, 1);
+        }
+
+        std::array<double, K> total{};
+        for (const auto& acc : partial)
+            for (size_t k = 0; k < K; ++k) total[k] += acc[k];
+        return total;
+    }
+
+private:
+    // Waits for the jobs of one call only, so several threads can share the pool
+    struct Latch {
+        explicit Latch(size_t count) : count(count) {}
+
+        void countDown() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--count == 0) done.notify_all();
+        }
+
+        void wait() {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this]() { return count == 0; });
+        }
+
+        size_t count;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    TopologyExecutor executor;
+    size_t chunk;
+};
+
+// Pool shared by all split evaluations of the process, started on first use
+SplitReducer& split_reducer() {
+    static SplitReducer reducer;
+    return reducer;
+}
+
+// f10 and f11 from their sums, as the f-functions combine them
+inline double ackleyFromSums(double squares, double cos2pi, size_t n) {
+    return -20.0 * std::exp(-0.2 * std::sqrt(squares / n)) - std::exp(cos2pi / n) + 20.0 + M_E;
+}
+
+inline double griewankFromSums(double squares, double cos_sqrt) { return squares / 4000.0 - cos_sqrt + 1.0; }
+
+// The value of f<function_id> at x from split sums; NaN if the benchmark has no split form
+double split_evaluate(int function_id, const double* x, size_t n, SplitReducer& reducer) {
+    switch (function_id) {
+    case 1:
+    case 14: {
+        double f1 = reducer.sums<1>(x, n, [](double v, std::array<double, 1>& acc) { acc[0] += v * v; })[0];
+        if (function_id == 1) return f1;
+        double result = 0.0;
+        for (int i = 0; i < 10; ++i) result += 1.0 * f1 * (5.0 / 100.0);
+        return result;
+    }
+    case 2:
+    case 15: {
+        double s = reducer.sums<1>(x, n, [](double v, std::array<double, 1>& acc) { acc[0] += std::abs(v); })[0];
+        double f2 = s + s * s;
+        if (function_id == 2) return f2;
+        double result = 0.0;
+        for (int i = 0; i < 10; ++i) result += 1.0 * f2 * (5.0 / 100.0);
+        return result;
+    }
+    case 8:
+        return reducer.sums<1>(x, n, [](double v, std::array<double, 1>& acc) { acc[0] -= v * std::sin(std::sqrt(std::abs(v))); })[0];
+    case 9:
+        return reducer.sums<1>(x, n, [](double v, std::array<double, 1>& acc) {
+            acc[0] = acc[0] + v * v - 10.0 * std::cos(2.0 * M_PI * v) + 10.0;
+        })[0];
+    case 10: {
+        auto s = reducer.sums<2>(x, n, [](double v, std::array<double, 2>& acc) {
+            acc[0] += v * v;
+            acc[1] += std::cos(2.0 * M_PI * v);
+        });
+        return ackleyFromSums(s[0], s[1], n);
+    }
+    case 11: {
+        auto s = reducer.sums<2>(x, n, [](double v, std::array<double, 2>& acc) {
+            acc[0] += v * v;
+            acc[1] += std::cos(std::sqrt(std::abs(v)));
+        });
+        return griewankFromSums(s[0], s[1]);
+    }
+    case 18:
+    case 19: {
+        // f9, f2, f11, f10, f1 in one pass
+        auto s = reducer.sums<5>(x, n, [](double v, std::array<double, 5>& acc) {
+            double c = std::cos(2.0 * M_PI * v);
+            acc[0] += v * v;
+            acc[1] += std::abs(v);
+            acc[2] = acc[2] + v * v - 10.0 * c + 10.0;
+            acc[3] += c;
+            acc[4] += std::cos(std::sqrt(std::abs(v)));
+        });
+        double f1 = s[0], f2 = s[1] + s[1] * s[1], f9 = s[2];
+        double f10 = ackleyFromSums(s[0], s[3], n), f11 = griewankFromSums(s[0], s[4]);
+        const double values[10] = {f9, f9, f2, f2, f11, f11, f10, f10, f1, f1};
+        const double biases18[10] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+        const double lambdas18[10] = {1/5.0, 1/5.0, 5/0.5, 5/0.5, 5/100.0, 5/100.0, 5/32.0, 5/32.0, 5/100.0, 5/100.0};
+        const double biases19[10] = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1};
+        const double lambdas19[10] = {0.1 * 1/5.0, 0.2 * 1/5.0, 0.3 * 5/0.5, 0.4 * 5/0.5, 0.5 * 5/100.0, 0.6 * 5/100.0, 0.7 * 5/32.0, 0.8 * 5/32.0, 0.9 * 5/100.0, 1 * 5/100.0};
+        const double* biases = function_id == 18 ? biases18 : biases19;
+        const double* lambdas = function_id == 18 ? lambdas18 : lambdas19;
+        double result = 0.0;
+        for (int i = 0; i < 10; ++i) result += biases[i] * values[i] * lambdas[i];
+        return result;
+    }
+    default:
+        return std::nan("");
+    }
+}
+
+bool has_split_form(int function_id) {
+    return function_id == 1 || function_id == 2 || (function_id >= 8 && function_id <= 11) || function_id == 14 ||
+           function_id == 15 || function_id == 18 || function_id == 19;
+}
+
+// f<function_id> that splits every evaluation with at least threshold coordinates;
+// the plain function below the threshold and for benchmarks without a split form
+Objective split_objective(int function_id, Objective benchmark_function, size_t threshold = split_eval_threshold) {
+    if (!has_split_form(function_id)) return benchmark_function;
+    return [function_id, threshold, benchmark_function = std::move(benchmark_function)](const std::vector<double>& position) {
+        if (position.size() < threshold) return benchmark_function(position);
+        return split_evaluate(function_id, position.data(), position.size(), split_reducer());
+    };
+}
@@ -0,0 +1,190 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include "benchmarks.h"
+#include "random.cpp"
+#include "termination.cpp"
+#include "initialization.cpp"
+#include "simd.cpp"
+#include "interleave.cpp"
+#include "topology.cpp"
+
+// SSA with the follower chain as a scan.
+// In ssa() follower i becomes clamp((x_i + y_{i-1}) / 2 + n_i) from the already moved salp
+// i - 1, a chain down the whole population. Each link is a map y -> clamp(a * y + b, lo, hi)
+// (a = 1/2, b = x_i / 2 + n_i, lo/hi = bounds), and such maps stay of that form under
+// composition because a >= 0. The followers are split into chunks: every chunk composes its
+// links into one map, the chunk maps are chained from the leader to get the salp in front of
+// each chunk, and every chunk then runs its own part of the chain. Chunks are independent in
+// the first and last phase (they run on an executor if one is given); within a chunk all
+// dimensions move together in vector lanes (simd.cpp). The noise n_i is drawn up front in the
+// order ssa() draws it, and all salps are evaluated with one batch call.
+//
+// With one chunk the positions are bit-identical to ssa(). With more chunks the salp in front
+// of a chunk comes from the composed map, whose rounding differs by a few ULP; every link
+// halves such a difference, so the chain does not build it up.
+
+// y -> clamp(a * y + b, lower, upper) per dimension, a shared by all dimensions
+struct ChainMap {
+    double a = 1.0;
+    std::vector<double> b, lower, upper;
+
+    void reset(size_t dims) {
+        a = 1.0;
+        b.assign(dims, 0.0);
+        lower.assign(dims, -std::numeric_limits<double>::infinity());
+        upper.assign(dims, std::numeric_limits<double>::infinity());
+    }
+};
+
+class SsaScan {
+public:
+    SsaScan(int num_salps, int max_iter, const std::vector<std::pair<double, double>>& search_space,
+            size_t num_chunks = 1, TopologyExecutor* executor = nullptr)
+        : num_salps(num_salps), max_iter(max_iter), dims(search_space.size()), executor(executor), search_space(search_space),
+          salps(num_salps * dims), fitness(num_salps), noise((num_salps - 1) * dims) {
+        for (const auto& bound : search_space) {
+            lower.push_back(bound.first);
+            upper.push_back(bound.second);
+        }
+        // Chunks of followers 1 .. num_salps - 1
+        size_t followers = num_salps > 1 ? num_salps - 1 : 0;
+        num_chunks = std::max<size_t>(1, std::min(num_chunks, followers));
+        for (size_t c = 0; c <= num_chunks; ++c) chunk_start.push_back(1 + followers * c / num_chunks);
+        maps.resize(num_chunks);
+        carries.resize(num_chunks, std::vector<double>(dims));
+    }
+
+    std::pair<std::vector<double>, double> run(const PopulationEvaluator& evaluator) {
+        initialize_population(salps.data(), num_salps, search_space);
+        bool solved = evaluate(evaluator);
+
+        for (int t = 0; t < max_iter && !solved; ++t) {
+            int best_index = static_cast<int>(std::min_element(fitness.begin(), fitness.end()) - fitness.begin());
+            std::copy(salp(best_index), salp(best_index) + dims, carries[0].begin());
+            std::copy(carries[0].begin(), carries[0].end(), salp(0)); // the first salp follows the lead
+
+            double w = 1.0 - (static_cast<double>(t) / max_iter);
+            noisy = t > max_iter / 2;
+            if (noisy)
+                for (double& n : noise) n = w * (2.0 * randomUnit() - 1.0);
+
+            if (maps.size() > 1) {
+                forEachChunk([this](size_t c) { composeChunk(c); });
+                for (size_t c = 1; c < maps.size(); ++c) applyMap(maps[c - 1], carries[c - 1], carries[c]);
+            }
+            forEachChunk([this](size_t c) { followChunk(c); });
+
+            solved = evaluate(evaluator);
+        }
+
+        int best_index = static_cast<int>(std::min_element(fitness.begin(), fitness.end()) - fitness.begin());
+        return {std::vector<double>(salp(best_index), salp(best_index) + dims), fitness[best_index]};
+    }
+
+private:
+    double* salp(size_t i) { return &salps[i * dims]; }
+
+    template <typename Job>
+    void forEachChunk(const Job& job) {
+        if (!executor || maps.size() == 1) {
+            for (size_t c = 0; c < maps.size(); ++c) job(c);
+            return;
+        }
+        for (size_t c = 0; c < maps.size(); ++c) executor->submit(c, [&job, c]() { job(c); });
+        executor->wait();
+    }
+
+    // b of the link of follower i: x_i / 2 (+ n_i)
+    SimdDouble linkOffset(size_t i, size_t j) {
+        SimdDouble b = loadLanes(salp(i) + j) * 0.5;
+        return noisy ? b + loadLanes(&noise[(i - 1) * dims + j]) : b;
+    }
+
+    // Composes the links of chunk c into maps[c]
+    void composeChunk(size_t c) {
+        ChainMap& map = maps[c];
+        map.reset(dims);
+        for (size_t i = chunk_start[c]; i < chunk_start[c + 1]; ++i) {
+            size_t j = 0;
+            for (; j + simd_lanes <= dims; j += simd_lanes) {
+                SimdDouble b = linkOffset(i, j), lo = loadLanes(&lower[j]), hi = loadLanes(&upper[j]);
+                storeLanes(&map.b[j], loadLanes(&map.b[j]) * 0.5 + b);
+                storeLanes(&map.lower[j], clampLanes(loadLanes(&map.lower[j]) * 0.5 + b, lo, hi));
+                storeLanes(&map.upper[j], clampLanes(loadLanes(&map.upper[j]) * 0.5 + b, lo, hi));
+            }
+            for (; j < dims; ++j) {
+                double b = salp(i)[j] * 0.5 + (noisy ? noise[(i - 1) * dims + j] : 0.0);
+                map.b[j] = map.b[j] * 0.5 + b;
+                map.lower[j] = std::min(std::max(map.lower[j] * 0.5 + b, lower[j]), upper[j]);
+                map.upper[j] = std::min(std::max(map.upper[j] * 0.5 + b, lower[j]), upper[j]);
+            }
+            map.a *= 0.5;
+        }
+    }
+
+    void applyMap(const ChainMap& map, const std::vector<double>& y, std::vector<double>& result) {
+        for (size_t j = 0; j < dims; ++j)
+            result[j] = std::min(std::max(map.a * y[j] + map.b[j], map.lower[j]), map.upper[j]);
+    }
+
+    // The chain of chunk c, starting from the salp in front of it, with the operations of ssa()
+    void followChunk(size_t c) {
+        const double* previous = carries[c].data();
+        for (size_t i = chunk_start[c]; i < chunk_start[c + 1]; ++i) {
+            double* x = salp(i);
+            const double* n = &noise[(i - 1) * dims];
+            size_t j = 0;
+            for (; j + simd_lanes <= dims; j += simd_lanes) {
+                SimdDouble y = (loadLanes(x + j) + loadLanes(previous + j)) / 2.0;
+                if (noisy) y += loadLanes(n + j);
+                storeLanes(x + j, clampLanes(y, loadLanes(&lower[j]), loadLanes(&upper[j])));
+            }
+            for (; j < dims; ++j) {
+                double y = (x[j] + previous[j]) / 2;
+                if (noisy) y += n[j];
+                x[j] = std::min(std::max(y, lower[j]), upper[j]);
+            }
+            previous = x;
+        }
+    }
+
+    // All salps with one batch call; evaluations are counted as controlled_objective would
+    bool evaluate(const PopulationEvaluator& evaluator) {
+        evaluator(salps.data(), num_salps, dims, fitness.data());
+        bool solved = false;
+        for (double value : fitness) {
+            ++run_control.evaluations;
+            if (target_reached(value)) {
+                if (run_control.evaluations_to_target == 0) run_control.evaluations_to_target = run_control.evaluations;
+                solved = true;
+            }
+        }
+        return solved;
+    }
+
+    int num_salps;
+    int max_iter;
+    size_t dims;
+    TopologyExecutor* executor;
+    std::vector<std::pair<double, double>> search_space;
+    std::vector<double> lower, upper;
+    std::vector<double> salps; // N x D
+    std::vector<double> fitness;
+    std::vector<double> noise; // (N - 1) x D, w * (2r - 1) of every follower coordinate
+    bool noisy = false;
+    std::vector<size_t> chunk_start;
+    std::vector<ChainMap> maps;
+    std::vector<std::vector<double>> carries; // salp in front of each chunk
+};
+
+// ssa() with the scanned follower chain and batch evaluation; executor (optional) runs the chunks
+std::pair<std::vector<double>, double> ssa_scan(int num_salps, int max_iter,
+                                                const std::vector<std::pair<double, double>>& search_space,
+                                                const PopulationEvaluator& evaluator, size_t num_chunks = 1,
+                                                TopologyExecutor* executor = nullptr) {
+    SsaScan engine(num_salps, max_iter, search_space, num_chunks, executor);
+    return engine.run(evaluator);
+}
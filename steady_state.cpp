@@ -0,0 +1,138 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include "benchmarks.h"
+#include "ask_tell.cpp"
+#include "topology.cpp"
+#include "external_objective.cpp"
+
+// Asynchronous steady-state execution for slow objectives, on top of the ask/tell optimizers
+// of ask_tell.cpp. The driver keeps a fixed number of evaluations running on a thread pool and feeds every result
+// back as soon as it arrives, instead of waiting for the slowest evaluation of a generation.
+
+struct SteadyStateResult {
+    std::vector<double> best_solution;
+    double best_fitness;
+    long long evaluations;
+    double wall_seconds;
+    double busy_seconds;  // summed over all workers
+    double utilization;   // busy_seconds / (threads * wall_seconds)
+};
+
+// Runs the optimizer's whole evaluation budget with `in_flight` evaluations outstanding
+// on a pool of `num_threads` pinned threads
+SteadyStateResult run_steady_state(AskTellOptimizer& optimizer, const Objective& benchmark_function,
+                                   int num_threads, int in_flight) {
+    std::mutex mutex;
+    std::condition_variable completed_signal;
+    std::deque<std::pair<Candidate, double>> completed;
+    double busy_seconds = 0.0;
+
+    auto start_time = std::chrono::steady_clock::now();
+    {
+        TopologyExecutor executor(num_threads);
+        int running = 0;
+        Candidate candidate;
+
+        while (true) {
+            while (running < in_flight && optimizer.ask(candidate)) {
+                ++running;
+                executor.submit(0, [&, candidate]() {
+                    auto eval_start = std::chrono::steady_clock::now();
+                    double value = benchmark_function(candidate.position);
+                    std::chrono::duration<double> eval_time = std::chrono::steady_clock::now() - eval_start;
+                    std::lock_guard<std::mutex> lock(mutex);
+                    busy_seconds += eval_time.count();
+                    completed.push_back({candidate, value});
+                    completed_signal.notify_one();
+                });
+            }
+
+            if (running == 0) break; // finished, nothing left to collect
+
+            std::unique_lock<std::mutex> lock(mutex);
+            completed_signal.wait(lock, [&]() { return !completed.empty(); });
+            std::deque<std::pair<Candidate, double>> results;
+            results.swap(completed);
+            lock.unlock();
+            for (auto& result : results) {
+                optimizer.tell(result.first, result.second);
+                --running;
+            }
+        }
+        executor.wait();
+        num_threads = executor.threadCount();
+    }
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start_time;
+
+    auto [best_solution, best_fitness] = optimizer.best();
+    return {best_solution, best_fitness, optimizer.evaluationCount(), wall.count(), busy_seconds,
+            busy_seconds / (num_threads * wall.count())};
+}
+
+SteadyStateResult woa_steady_state(int num_agents, int max_iter, const std::vector<std::pair<double, double>>& search_space,
+                                   const Objective& benchmark_function, int num_threads, int in_flight) {
+    WoaAskTell optimizer(num_agents, max_iter, search_space);
+    return run_steady_state(optimizer, benchmark_function, num_threads, in_flight);
+}
+
+SteadyStateResult sca_steady_state(int num_agents, int max_iter, const std::vector<std::pair<double, double>>& search_space,
+                                   const Objective& benchmark_function, int num_threads, int in_flight) {
+    ScaAskTell optimizer(num_agents, max_iter, search_space);
+    return run_steady_state(optimizer, benchmark_function, num_threads, in_flight);
+}
+
+SteadyStateResult aoa_steady_state(int num_agents, int max_iter, const std::vector<std::pair<double, double>>& search_space,
+                                   const Objective& benchmark_function, int num_threads, int in_flight) {
+    AoaAskTell optimizer(num_agents, max_iter, search_space);
+    return run_steady_state(optimizer, benchmark_function, num_threads, in_flight);
+}
+
+// The same optimizers against an evaluator process (external_objective.cpp). Candidates are asked
+// in batches of up to maxBatch() and up to slotCount() batches are in flight; the oldest batch is
+// collected and told only when no slot is free or no agent is left without a pending candidate,
+// so the optimizer prepares the next batches while the evaluator works. busy_seconds is the time
+// the evaluator spent on the batches, utilization its share of the wall time.
+SteadyStateResult run_steady_state_external(AskTellOptimizer& optimizer, ExternalEvaluator& evaluator) {
+    struct Batch {
+        uint32_t ticket;
+        std::vector<Candidate> candidates;
+    };
+    const size_t dims = evaluator.dimensions();
+    std::deque<Batch> in_flight;
+    std::vector<double> positions, values;
+    double busy_seconds = 0.0;
+
+    auto start_time = std::chrono::steady_clock::now();
+    while (true) {
+        while (in_flight.size() < evaluator.slotCount()) {
+            Batch batch;
+            Candidate candidate;
+            while (batch.candidates.size() < evaluator.maxBatch() && optimizer.ask(candidate))
+                batch.candidates.push_back(candidate);
+            if (batch.candidates.empty()) break;
+            positions.resize(batch.candidates.size() * dims);
+            for (size_t c = 0; c < batch.candidates.size(); ++c)
+                std::copy(batch.candidates[c].position.begin(), batch.candidates[c].position.end(), positions.begin() + c * dims);
+            batch.ticket = evaluator.submit(positions.data(), batch.candidates.size(), batch.candidates[0].position.size());
+            in_flight.push_back(std::move(batch));
+        }
+        if (in_flight.empty()) break; // finished, nothing left to collect
+
+        Batch& oldest = in_flight.front();
+        values.resize(oldest.candidates.size());
+        busy_seconds += evaluator.collect(oldest.ticket, values.data());
+        for (size_t c = 0; c < oldest.candidates.size(); ++c) optimizer.tell(oldest.candidates[c], values[c]);
+        in_flight.pop_front();
+    }
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start_time;
+
+    auto [best_solution, best_fitness] = optimizer.best();
+    return {best_solution, best_fitness, optimizer.evaluationCount(), wall.count(), busy_seconds, busy_seconds / wall.count()};
+}
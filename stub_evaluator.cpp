@@ -0,0 +1,33 @@
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <thread>
+#include <chrono>
+#include "benchmarks.h"
+#include "external_objective.cpp"
+#include "registry.cpp"
+
+// Minimal external evaluator for tests of external_objective.cpp.
+// Started by ExternalEvaluator as `stub_evaluator <shm name>`; applies f<function_id> (1..19)
+// to every candidate of a batch, through the registry's batch kernel where there is one.
+// STUB_EVALUATOR_DELAY_US adds a per-candidate delay to imitate an expensive simulator.
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: stub_evaluator <shm name>" << std::endl;
+        return 1;
+    }
+
+    const char* delay_env = std::getenv("STUB_EVALUATOR_DELAY_US");
+    const long delay_us = delay_env ? std::atol(delay_env) : 0;
+
+    return serve_ring(argv[1], [&](uint32_t function_id, const double* positions, size_t count, size_t dims, double* values) {
+        const BenchmarkInfo* benchmark = find_benchmark(static_cast<int>(function_id));
+        if (!benchmark) {
+            std::fill(values, values + count, 0.0);
+            return;
+        }
+        evaluate_population(*benchmark, positions, count, dims, values);
+        if (delay_us > 0) std::this_thread::sleep_for(std::chrono::microseconds(delay_us * count));
+    });
+}
@@ -0,0 +1,251 @@
+#pragma once
+#include <vector>
+#include <queue>
+#include <numeric>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "benchmarks.h"
+#include "ask_tell.cpp"
+
+// Surrogate pre-screening for costly objectives.
+// Every true evaluation goes into an archive; a k-nearest-neighbour model over the archive
+// predicts the value of new candidates. Each generation the optimizer proposes its candidates,
+// the model ranks them by predicted improvement over the agent they would replace, and only the
+// most promising part is evaluated. The rest is dropped, as the greedy replacement would most
+// likely have rejected it anyway.
+
+// Evaluated points with a k-d tree index. New points are appended to an unindexed tail that is
+// searched linearly; the tree is rebuilt once the tail gets long relative to the indexed part.
+class SurrogateArchive {
+public:
+    SurrogateArchive(size_t num_dimensions, size_t capacity = 4096)
+        : dims(num_dimensions), capacity(capacity) {}
+
+    void add(const std::vector<double>& position, double value) {
+        points.insert(points.end(), position.begin(), position.end());
+        values.push_back(value);
+        // Oldest quarter goes first: it lies mostly where the population has already left
+        if (values.size() > capacity) {
+            size_t drop = capacity / 4;
+            points.erase(points.begin(), points.begin() + drop * dims);
+            values.erase(values.begin(), values.begin() + drop);
+            indexed = 0;
+        }
+        if (values.size() - indexed > std::max<size_t>(64, indexed / 4))
+            rebuild();
+    }
+
+    size_t size() const { return values.size(); }
+
+    // Inverse-distance weighted mean of the k nearest archived values
+    double predict(const std::vector<double>& position, int k) const {
+        std::vector<std::pair<double, size_t>> neighbours = nearest(position.data(), k);
+        double weighted = 0.0, weights = 0.0;
+        for (auto& [distance2, index] : neighbours) {
+            if (distance2 == 0.0) return values[index];
+            double weight = 1.0 / distance2;
+            weighted += weight * values[index];
+            weights += weight;
+        }
+        return weights > 0.0 ? weighted / weights : 0.0;
+    }
+
+    // (squared distance, point index) of the k nearest points, closest first
+    std::vector<std::pair<double, size_t>> nearest(const double* query, int k) const {
+        Neighbours heap;
+        if (indexed > 0) searchTree(query, 0, indexed, k, heap);
+        for (size_t p = indexed; p < values.size(); ++p) offer(query, p, k, heap);
+
+        std::vector<std::pair<double, size_t>> result(heap.size());
+        for (size_t r = result.size(); r-- > 0; heap.pop()) result[r] = heap.top();
+        return result;
+    }
+
+private:
+    using Neighbours = std::priority_queue<std::pair<double, size_t>>; // max-heap on distance
+
+    double distance2(const double* query, size_t p) const {
+        const double* point = &points[p * dims];
+        double sum = 0.0;
+        for (size_t j = 0; j < dims; ++j) sum += (query[j] - point[j]) * (query[j] - point[j]);
+        return sum;
+    }
+
+    void offer(const double* query, size_t p, int k, Neighbours& heap) const {
+        double d = distance2(query, p);
+        if (static_cast<int>(heap.size()) < k) heap.push({d, p});
+        else if (d < heap.top().first) {
+            heap.pop();
+            heap.push({d, p});
+        }
+    }
+
+    // Implicit tree over order[lo, hi): the median order[mid] splits on split_dim[mid]
+    void rebuild() {
+        indexed = values.size();
+        order.resize(indexed);
+        std::iota(order.begin(), order.end(), 0);
+        split_dim.assign(indexed, 0);
+        build(0, indexed);
+    }
+
+    void build(size_t lo, size_t hi) {
+        if (hi - lo <= 1) return;
+        // Split along the dimension with the widest spread
+        size_t best_dim = 0;
+        double best_spread = -1.0;
+        for (size_t j = 0; j < dims; ++j) {
+            double low = points[order[lo] * dims + j], high = low;
+            for (size_t p = lo + 1; p < hi; ++p) {
+                low = std::min(low, points[order[p] * dims + j]);
+                high = std::max(high, points[order[p] * dims + j]);
+            }
+            if (high - low > best_spread) {
+                best_spread = high - low;
+                best_dim = j;
+            }
+        }
+        size_t mid = lo + (hi - lo) / 2;
+        std::nth_element(order.begin() + lo, order.begin() + mid, order.begin() + hi, [&](size_t a, size_t b) {
+            return points[a * dims + best_dim] < points[b * dims + best_dim];
+        });
+        split_dim[mid] = best_dim;
+        build(lo, mid);
+        build(mid + 1, hi);
+    }
+
+    void searchTree(const double* query, size_t lo, size_t hi, int k, Neighbours& heap) const {
+        if (lo >= hi) return;
+        size_t mid = lo + (hi - lo) / 2;
+        offer(query, order[mid], k, heap);
+        if (hi - lo == 1) return;
+
+        double diff = query[split_dim[mid]] - points[order[mid] * dims + split_dim[mid]];
+        bool left_first = diff < 0.0;
+        if (left_first) searchTree(query, lo, mid, k, heap);
+        else searchTree(query, mid + 1, hi, k, heap);
+        // The far side can only help if the splitting plane is closer than the k-th neighbour
+        if (static_cast<int>(heap.size()) < k || diff * diff < heap.top().first) {
+            if (left_first) searchTree(query, mid + 1, hi, k, heap);
+            else searchTree(query, lo, mid, k, heap);
+        }
+    }
+
+    size_t dims;
+    size_t capacity;
+    std::vector<double> points; // row-major, dims per point
+    std::vector<double> values;
+    std::vector<size_t> order;
+    std::vector<size_t> split_dim;
+    size_t indexed = 0; // points order[0 .. indexed) are in the tree
+};
+
+struct SurrogateConfig {
+    int neighbours = 8;              // k of the k-NN model
+    double evaluate_fraction = 0.3;  // share of each generation sent to the true objective
+    int warmup_generations = 2;      // generations evaluated in full before screening starts
+    size_t archive_capacity = 4096;
+};
+
+struct SurrogateResult {
+    std::vector<double> best_solution;
+    double best_fitness;
+    long long evaluations; // true objective calls
+    long long screened;    // candidates dropped on the model's prediction
+    double model_seconds;  // time spent in the archive and the predictions
+};
+
+// Runs the optimizer generation by generation with surrogate pre-screening.
+// evaluate_fraction = 1 evaluates everything and reproduces the unscreened run.
+SurrogateResult run_surrogate_screened(AskTellOptimizer& optimizer, const Objective& benchmark_function,
+                                       size_t num_dimensions, const SurrogateConfig& config = {}) {
+    SurrogateArchive archive(num_dimensions, config.archive_capacity);
+    long long screened = 0;
+    double model_seconds = 0.0;
+    std::vector<Candidate> generation;
+    std::vector<std::pair<double, size_t>> ranking; // predicted improvement, candidate
+
+    for (int g = 0; ; ++g) {
+        generation.clear();
+        Candidate candidate;
+        while (optimizer.ask(candidate)) generation.push_back(candidate);
+        if (generation.empty()) break;
+
+        size_t num_evaluated = generation.size();
+        bool screening = g >= config.warmup_generations && config.evaluate_fraction < 1.0
+                         && archive.size() > static_cast<size_t>(config.neighbours);
+        ranking.clear();
+        for (size_t c = 0; c < generation.size(); ++c) ranking.push_back({0.0, c});
+        if (screening) {
+            auto model_start = std::chrono::steady_clock::now();
+            for (auto& [improvement, c] : ranking)
+                improvement = archive.predict(generation[c].position, config.neighbours)
+                              - optimizer.agentFitness(generation[c].agent);
+            std::sort(ranking.begin(), ranking.end());
+            model_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - model_start).count();
+            num_evaluated = std::max<size_t>(1, static_cast<size_t>(std::ceil(config.evaluate_fraction * generation.size())));
+        }
+
+        for (size_t r = 0; r < ranking.size(); ++r) {
+            const Candidate& chosen = generation[ranking[r].second];
+            if (r >= num_evaluated) {
+                optimizer.discard(chosen);
+                ++screened;
+                continue;
+            }
+            double value = benchmark_function(chosen.position);
+            optimizer.tell(chosen, value);
+            auto model_start = std::chrono::steady_clock::now();
+            archive.add(chosen.position, value);
+            model_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - model_start).count();
+        }
+    }
+
+    auto [best_solution, best_fitness] = optimizer.best();
+    return {best_solution, best_fitness, optimizer.evaluationCount(), screened, model_seconds};
+}
+
+SurrogateResult woa_surrogate(int num_agents, int max_iter, const std::vector<std::pair<double, double>>& search_space,
+                              const Objective& benchmark_function, const SurrogateConfig& config = {}) {
+    WoaAskTell optimizer(num_agents, max_iter, search_space);
+    return run_surrogate_screened(optimizer, benchmark_function, search_space.size(), config);
+}
+
+SurrogateResult sca_surrogate(int num_agents, int max_iter, const std::vector<std::pair<double, double>>& search_space,
+                              const Objective& benchmark_function, const SurrogateConfig& config = {}) {
+    ScaAskTell optimizer(num_agents, max_iter, search_space);
+    return run_surrogate_screened(optimizer, benchmark_function, search_space.size(), config);
+}
+
+SurrogateResult tlbo_surrogate(int num_agents, int max_iter, const std::vector<std::pair<double, double>>& search_space,
+                               const Objective& benchmark_function, const SurrogateConfig& config = {}) {
+    TlboAskTell optimizer(num_agents, max_iter, search_space);
+    return run_surrogate_screened(optimizer, benchmark_function, search_space.size(), config);
+}
+
+// Screened run against the unscreened run with the same seed
+struct SurrogateComparison {
+    double baseline_fitness;
+    double screened_fitness;
+    long long baseline_evaluations;
+    long long screened_evaluations;
+    double model_seconds;
+
+    double evaluationSavings() const { return 1.0 - static_cast<double>(screened_evaluations) / baseline_evaluations; }
+    double fitnessLoss() const { return screened_fitness - baseline_fitness; }
+};
+
+using SurrogateAlgorithm = std::function<SurrogateResult(const Objective&, const SurrogateConfig&)>;
+
+SurrogateComparison compare_surrogate(const SurrogateAlgorithm& algorithm, const Objective& benchmark_function,
+                                      const SurrogateConfig& config, uint64_t seed) {
+    SurrogateConfig full = config;
+    full.evaluate_fraction = 1.0;
+    seed_random(seed);
+    SurrogateResult baseline = algorithm(benchmark_function, full);
+    seed_random(seed);
+    SurrogateResult screened = algorithm(benchmark_function, config);
+    return {baseline.best_fitness, screened.best_fitness, baseline.evaluations, screened.evaluations,
+            screened.model_seconds};
+}
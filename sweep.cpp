@@ -0,0 +1,226 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <functional>
+#include <chrono>
+#include <iostream>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+// Sharded sweep over several worker processes.
+// The coordinator listens on a Unix-domain socket and hands out (algorithm, config, run) jobs;
+// workers connect, run the jobs and stream back fixed-size binary result records.
+// Jobs of a worker that disconnects before answering are put back into the queue.
+
+struct SweepJob {
+    uint32_t algorithm;
+    uint32_t config;
+    uint32_t run;
+    uint32_t shutdown; // non-zero: worker should exit
+};
+
+struct SweepResult {
+    uint32_t algorithm;
+    uint32_t config;
+    uint32_t run;
+    uint32_t restarts;              // of the diversity monitor, see diversity.cpp
+    double fitness;
+    double seconds;
+    double cache_hit_rate;
+    uint64_t evaluations;
+    uint64_t evaluations_to_target; // 0: target not reached
+    uint64_t peak_bytes;            // memory of the run, see memory.cpp
+    uint64_t steady_bytes;
+    double monitor_seconds;         // time in the diversity monitor
+    double spread;                  // final population spread / diagonal
+};
+
+using JobRunner = std::function<SweepResult(const SweepJob&)>;
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const char* p = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t n = send(fd, p, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool readAll(int fd, void* data, size_t size) {
+    char* p = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t n = recv(fd, p, size, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+sockaddr_un socketAddress(const std::string& socket_path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    return address;
+}
+
+// Worker loop: connect to the coordinator and run jobs until told to stop or disconnected
+int run_worker(const std::string& socket_path, const JobRunner& runner) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = socketAddress(socket_path);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << "Worker: cannot connect to " << socket_path << ": " << std::strerror(errno) << std::endl;
+        if (fd >= 0) close(fd);
+        return 1;
+    }
+
+    SweepJob job;
+    while (readAll(fd, &job, sizeof(job)) && !job.shutdown) {
+        SweepResult result = runner(job);
+        if (!writeAll(fd, &result, sizeof(result))) break;
+    }
+    close(fd);
+    return 0;
+}
+
+// Runs all jobs on `num_local_workers` local workers plus any worker that connects to
+// `socket_path` on its own (e.g. `main --worker PATH` started under numactl). A local worker is
+// worker_command with "--worker <socket_path>" appended, exec'd right after the fork, so it does
+// not inherit the coordinator's threads and locks. Without any worker for idle_timeout seconds
+// the sweep is abandoned. Returns the results in completion order.
+std::vector<SweepResult> run_coordinator(const std::string& socket_path, int num_local_workers,
+                                         const std::vector<SweepJob>& jobs, const std::vector<std::string>& worker_command,
+                                         double idle_timeout = 60.0, int max_respawns = 8) {
+    const size_t jobs_per_worker = 2; // one running, one queued so the worker never waits for us
+    signal(SIGPIPE, SIG_IGN);
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address = socketAddress(socket_path);
+    unlink(socket_path.c_str());
+    if (listen_fd < 0 || bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listen_fd, 64) != 0) {
+        std::cerr << "Coordinator: cannot listen on " << socket_path << ": " << std::strerror(errno) << std::endl;
+        return {};
+    }
+
+    // argv of the local workers, built before any fork: the child only calls execv
+    std::vector<std::string> command = worker_command;
+    command.push_back("--worker");
+    command.push_back(socket_path);
+    std::vector<char*> worker_argv;
+    for (std::string& argument : command) worker_argv.push_back(&argument[0]);
+    worker_argv.push_back(nullptr);
+
+    std::set<pid_t> children;
+    std::map<int, std::deque<size_t>> in_flight; // worker socket -> jobs sent to it, in order
+    auto spawn_worker = [&]() {
+        pid_t pid = fork();
+        if (pid == 0) {
+            execv(worker_argv[0], worker_argv.data());
+            _exit(127);
+        }
+        if (pid > 0) children.insert(pid);
+    };
+    for (int w = 0; w < num_local_workers; ++w) spawn_worker();
+
+    std::deque<size_t> pending;
+    for (size_t j = 0; j < jobs.size(); ++j) pending.push_back(j);
+    std::vector<bool> done(jobs.size(), false);
+    std::vector<SweepResult> results;
+    auto last_activity = std::chrono::steady_clock::now();
+
+    auto dispatch = [&](int fd) {
+        while (in_flight[fd].size() < jobs_per_worker && !pending.empty()) {
+            size_t j = pending.front();
+            if (!writeAll(fd, &jobs[j], sizeof(SweepJob))) return;
+            pending.pop_front();
+            in_flight[fd].push_back(j);
+        }
+    };
+
+    auto drop_worker = [&](int fd) {
+        for (size_t j : in_flight[fd])
+            if (!done[j]) pending.push_front(j);
+        in_flight.erase(fd);
+        close(fd);
+    };
+
+    while (results.size() < jobs.size()) {
+        // Reap dead local workers and replace them while work remains
+        int status;
+        pid_t pid;
+        while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+            children.erase(pid);
+            if (max_respawns > 0 && results.size() < jobs.size() && static_cast<int>(children.size()) < num_local_workers) {
+                --max_respawns;
+                spawn_worker();
+            }
+        }
+
+        std::vector<pollfd> fds;
+        fds.push_back({listen_fd, POLLIN, 0});
+        for (auto& entry : in_flight) fds.push_back({entry.first, POLLIN, 0});
+        if (poll(fds.data(), fds.size(), 200) < 0 && errno != EINTR) break;
+
+        if (fds[0].revents & POLLIN) {
+            int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd >= 0) {
+                last_activity = std::chrono::steady_clock::now();
+                in_flight[fd];
+                dispatch(fd);
+            }
+        }
+        for (size_t k = 1; k < fds.size(); ++k) {
+            if (!(fds[k].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            int fd = fds[k].fd;
+            SweepResult result;
+            if (!readAll(fd, &result, sizeof(result)) || in_flight[fd].empty()) {
+                drop_worker(fd);
+                continue;
+            }
+            size_t j = in_flight[fd].front();
+            in_flight[fd].pop_front();
+            last_activity = std::chrono::steady_clock::now();
+            if (!done[j]) {
+                done[j] = true;
+                results.push_back(result);
+            }
+            dispatch(fd);
+        }
+        // Requeued jobs go to idle workers
+        for (auto& entry : in_flight) dispatch(entry.first);
+
+        if (in_flight.empty() && children.empty() && !pending.empty() && max_respawns <= 0 && num_local_workers > 0) {
+            std::cerr << "Coordinator: all workers failed, " << pending.size() << " jobs left" << std::endl;
+            break;
+        }
+        if (in_flight.empty() && children.empty() &&
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - last_activity).count() > idle_timeout) {
+            std::cerr << "Coordinator: no worker for " << idle_timeout << " s, " << jobs.size() - results.size() << " jobs left" << std::endl;
+            break;
+        }
+    }
+
+    SweepJob stop{0, 0, 0, 1};
+    for (auto& entry : in_flight) {
+        writeAll(entry.first, &stop, sizeof(stop));
+        close(entry.first);
+    }
+    for (pid_t child : children) waitpid(child, nullptr, 0);
+    close(listen_fd);
+    unlink(socket_path.c_str());
+    return results;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <limits>
+#include <cstdint>
+#include "benchmarks.h"
+
+// Target-based termination.
+// A run gets a target value (usually the benchmark's known optimum plus a tolerance); the
+// optimizers stop as soon as a value at or below it is found. Like the random stream, the
+// target belongs to the calling thread, so parallel runs each have their own. Without a target
+// (the default, -inf) the optimizers run their full iteration budget.
+
+struct RunControl {
+    double target = -std::numeric_limits<double>::infinity();
+    uint64_t evaluations = 0;           // counted by controlled_objective
+    uint64_t evaluations_to_target = 0; // evaluation that first reached the target, 0: not reached
+};
+
+inline thread_local RunControl run_control;
+
+// Starts a run with the given target; -inf disables early termination
+void set_run_target(double target) {
+    run_control = RunControl{target, 0, 0};
+}
+
+// Checked by the optimizers with each new (best) value
+inline bool target_reached(double value) {
+    return value <= run_control.target;
+}
+
+// Counts evaluations and remembers when the target was first reached
+Objective controlled_objective(Objective benchmark_function) {
+    return [benchmark_function = std::move(benchmark_function)](const std::vector<double>& position) {
+        double value = benchmark_function(position);
+        ++run_control.evaluations;
+        if (run_control.evaluations_to_target == 0 && target_reached(value))
+            run_control.evaluations_to_target = run_control.evaluations;
+        return value;
+    };
+}
+
+// Expected running time over several runs: evaluations spent by all runs (up to the target in
+// successful ones) per successful run
+struct ErtStatistics {
+    int runs = 0;
+    int successes = 0;
+    double evaluations = 0.0;
+
+    void add(uint64_t run_evaluations, uint64_t evaluations_to_target) {
+        ++runs;
+        if (evaluations_to_target > 0) ++successes;
+        evaluations += evaluations_to_target > 0 ? evaluations_to_target : run_evaluations;
+    }
+
+    double successRate() const { return runs ? static_cast<double>(successes) / runs : 0.0; }
+
+    double expectedRunningTime() const {
+        return successes ? evaluations / successes : std::numeric_limits<double>::infinity();
+    }
+};
@@ -0,0 +1,265 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <map>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+
+// CPU topology from Linux sysfs and a thread pool pinned to it.
+// One worker per allowed CPU, workers grouped by shared L3 cache. Jobs carry a group key
+// (e.g. the benchmark): jobs of a group go to the same L3 domain, so co-located runs share the
+// benchmark's working set (rotation matrices, cached values). Everything a job allocates is
+// first touched by its pinned thread, so the kernel places it on that thread's NUMA node.
+// With a memory budget, a job is started only when its estimated footprint fits next to the
+// jobs already running; a job larger than the whole budget runs alone.
+
+struct CacheDomain {
+    int node;              // NUMA node of the CPUs
+    std::vector<int> cpus; // CPUs sharing one L3
+};
+
+// "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}
+std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n") continue;
+        size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+std::string readSysfs(const std::string& path) {
+    std::ifstream file(path);
+    std::string value;
+    std::getline(file, value);
+    return value;
+}
+
+// L3 domains of the CPUs this process may run on. Without sysfs (containers, other OSes)
+// everything falls back to one domain on node 0.
+std::vector<CacheDomain> read_topology() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+
+    std::map<int, int> cpu_node;
+    for (int node = 0; node < 256; ++node) {
+        std::string list = readSysfs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        for (int cpu : parseCpuList(list)) cpu_node[cpu] = node;
+    }
+
+    std::map<std::string, CacheDomain> domains; // keyed by the L3 shared_cpu_list
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (!CPU_ISSET(cpu, &allowed)) continue;
+        std::string cache_dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cache/";
+        std::string shared;
+        for (int index = 0; index < 8; ++index) {
+            std::string dir = cache_dir + "index" + std::to_string(index) + "/";
+            if (readSysfs(dir + "level") == "3") {
+                shared = readSysfs(dir + "shared_cpu_list");
+                break;
+            }
+        }
+        int node = cpu_node.count(cpu) ? cpu_node[cpu] : 0;
+        std::string key = std::to_string(node) + ":" + shared;
+        domains[key].node = node;
+        domains[key].cpus.push_back(cpu);
+    }
+
+    std::vector<CacheDomain> result;
+    for (auto& entry : domains) result.push_back(entry.second);
+    if (result.empty()) {
+        CacheDomain all{0, {}};
+        for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu) all.cpus.push_back(cpu);
+        result.push_back(all);
+    }
+    return result;
+}
+
+class TopologyExecutor {
+public:
+    // num_threads = 0: one worker per allowed CPU. More threads than CPUs (for objectives that
+    // mostly wait) share the CPUs in the same order.
+    explicit TopologyExecutor(size_t num_threads = 0) : domains(read_topology()) {
+        // CPUs interleaved over the domains, so a small pool still covers every node
+        std::vector<std::pair<size_t, int>> placement; // domain, cpu
+        for (size_t k = 0; placement.size() < countCpus(); ++k)
+            for (size_t d = 0; d < domains.size(); ++d)
+                if (k < domains[d].cpus.size()) placement.push_back({d, domains[d].cpus[k]});
+        if (num_threads == 0) num_threads = placement.size();
+
+        queues.resize(domains.size());
+        for (size_t d = 0; d < domains.size(); ++d) completed_per_domain[d] = 0;
+        for (size_t w = 0; w < num_threads; ++w) {
+            auto [d, cpu] = placement[w % placement.size()];
+            workers.emplace_back([this, d = d, cpu = cpu]() { workerLoop(d, cpu); });
+        }
+    }
+
+    ~TopologyExecutor() {
+        wait();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        work_available.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    // Jobs with the same group run in the same L3 domain when possible. memory_bytes is the
+    // job's estimated footprint, checked against the memory budget.
+    void submit(size_t group, std::function<void()> job, size_t memory_bytes = 0) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            size_t domain = domainOfGroup(group);
+            queues[domain].push_back({std::move(job), memory_bytes});
+            ++outstanding;
+        }
+        work_available.notify_all();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        all_done.wait(lock, [this]() { return outstanding == 0; });
+    }
+
+    // Jobs per second completed by the workers of every NUMA node since the executor started
+    std::map<int, double> nodeThroughput() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        std::map<int, double> throughput;
+        for (size_t d = 0; d < domains.size(); ++d)
+            throughput[domains[d].node] += seconds > 0.0 ? completed_per_domain.at(d) / seconds : 0.0;
+        return throughput;
+    }
+
+    size_t threadCount() const { return workers.size(); }
+
+    // 0: no limit
+    void setMemoryBudget(size_t bytes) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            memory_budget = bytes;
+        }
+        work_available.notify_all();
+    }
+
+    // Highest sum of estimates of concurrently running jobs
+    size_t peakReservedMemory() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return peak_reserved;
+    }
+
+private:
+    size_t countCpus() const {
+        size_t total = 0;
+        for (auto& domain : domains) total += domain.cpus.size();
+        return total;
+    }
+
+    size_t domainOfGroup(size_t group) {
+        auto it = group_domain.find(group);
+        if (it != group_domain.end()) return it->second;
+        // New groups go to the domain with the least queued work per CPU
+        size_t best = 0;
+        double best_load = 1e300;
+        for (size_t d = 0; d < domains.size(); ++d) {
+            double load = static_cast<double>(queues[d].size() + groups_per_domain[d]) / domains[d].cpus.size();
+            if (load < best_load) {
+                best_load = load;
+                best = d;
+            }
+        }
+        ++groups_per_domain[best];
+        group_domain[group] = best;
+        return best;
+    }
+
+    void workerLoop(size_t domain, int cpu) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            // Own domain first, otherwise steal from the longest queue rather than idle
+            size_t source = domain;
+            size_t index = admissible(domain);
+            bool own = index != none;
+            for (size_t d = 0, longest = 0; !own && d < queues.size(); ++d) {
+                if (d == domain || queues[d].size() <= longest) continue;
+                size_t candidate = admissible(d);
+                if (candidate != none) {
+                    source = d;
+                    index = candidate;
+                    longest = queues[d].size();
+                }
+            }
+            if (index == none) {
+                if (stopping && outstanding == 0) return;
+                work_available.wait(lock);
+                continue;
+            }
+            QueuedJob job = std::move(queues[source][index]);
+            queues[source].erase(queues[source].begin() + index);
+            memory_reserved += job.memory_bytes;
+            peak_reserved = std::max(peak_reserved, memory_reserved);
+            lock.unlock();
+            job.run();
+            lock.lock();
+            memory_reserved -= job.memory_bytes;
+            ++completed_per_domain[domain];
+            if (--outstanding == 0) all_done.notify_all();
+            // Freed budget may admit a job another worker had to leave in the queue
+            if (memory_budget > 0) work_available.notify_all();
+        }
+    }
+
+    // First job of queue d that fits the memory budget; none if the queue is empty or nothing fits
+    size_t admissible(size_t d) const {
+        for (size_t i = 0; i < queues[d].size(); ++i) {
+            size_t bytes = queues[d][i].memory_bytes;
+            if (memory_budget == 0 || memory_reserved == 0 || memory_reserved + bytes <= memory_budget) return i;
+        }
+        return none;
+    }
+
+    struct QueuedJob {
+        std::function<void()> run;
+        size_t memory_bytes;
+    };
+
+    static constexpr size_t none = static_cast<size_t>(-1);
+
+    std::vector<CacheDomain> domains;
+    std::vector<std::deque<QueuedJob>> queues;
+    std::map<size_t, size_t> group_domain;
+    std::map<size_t, size_t> groups_per_domain;
+    std::map<size_t, size_t> completed_per_domain;
+    std::vector<std::thread> workers;
+    mutable std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable all_done;
+    size_t outstanding = 0;
+    size_t memory_budget = 0;
+    size_t memory_reserved = 0;
+    size_t peak_reserved = 0;
+    bool stopping = false;
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+};